@@ -0,0 +1,68 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_config.hpp"
+#include "../src/btop_shared.hpp"
+
+namespace {
+	using clock = std::chrono::steady_clock;
+
+	//* Time one Proc::collect() update after <churn> of the oldest processes exited and as many new ones started
+	double update_ns(Bench::FakeProc& proc, size_t churn, size_t runs = 5) {
+		double total = 0;
+		for (size_t i = 0; i < runs; i++) {
+			for (size_t n = 0; n < churn; n++) {
+				proc.remove_oldest();
+				proc.add();
+			}
+			const auto start = clock::now();
+			Proc::collect();
+			total += std::chrono::duration<double, std::nano>(clock::now() - start).count();
+		}
+		return total / runs;
+	}
+
+	//* Cost of a Proc::collect() update at growing numbers of pids, finding, adding and removing processes should scale linearly
+	//* "idle" updates only read 1 in 100 processes (proc_idle_refresh = 100), which leaves mostly the listing and pid index work
+	int proc_index(const vector<string>& args) {
+		fmt::println("{:>8} {:>12} {:>12} {:>12} {:>14} {:>14}", "pids", "first ms", "update ms", "idle ms", "update ns/pid", "idle ns/pid");
+		for (const size_t count : Bench::sizes(args, {10'000, 25'000, 50'000, 100'000})) {
+			Bench::FakeProc proc(count);
+			Bench::use_proc(proc.path());
+
+			//? The first update reads all processes as new and drops any left from the previous size
+			Config::set("proc_idle_refresh", 1);
+			const auto start = clock::now();
+			Proc::collect();
+			const double first = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			const size_t churn = std::max((size_t)1, count / 100);
+			const double update = update_ns(proc, churn);
+			Config::set("proc_idle_refresh", 100);
+			const double idle = update_ns(proc, churn);
+
+			fmt::println("{:>8} {:>12.1f} {:>12.1f} {:>12.1f} {:>14.0f} {:>14.0f}", count, first, update / 1e6, idle / 1e6, update / count, idle / count);
+		}
+		return 0;
+	}
+
+	const bool registered = Bench::add("proc_index", "Proc::collect() updates over a synthetic /proc with 1% of processes replaced per update", proc_index);
+}
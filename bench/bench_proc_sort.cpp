@@ -0,0 +1,116 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <algorithm>
+#include <random>
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_shared.hpp"
+#include "../src/btop_tools.hpp"
+
+namespace {
+	namespace rng = std::ranges;
+	using clock = std::chrono::steady_clock;
+	using Proc::proc_info;
+
+	//* Sort by moving whole proc_info entries with std::stable_sort, as proc_sorter() did before sorting through a key column
+	void stable_sorter(vector<proc_info>& procs, const string& sorting, bool reverse) {
+		const auto sorter = [&](auto proj) {
+			if (reverse) rng::stable_sort(procs, rng::less{}, proj);
+			else rng::stable_sort(procs, rng::greater{}, proj);
+		};
+		switch (Tools::v_index(Proc::sort_vector, sorting)) {
+			case 0: sorter(&proc_info::pid); break;
+			case 1: sorter([](const proc_info& p) -> const string& { return p.name.str(); }); break;
+			case 2: sorter([](const proc_info& p) -> const string& { return p.cmd.str(); }); break;
+			case 3: sorter(&proc_info::threads); break;
+			case 4: sorter([](const proc_info& p) -> const string& { return p.user.str(); }); break;
+			case 5: sorter(&proc_info::mem); break;
+			case 6: sorter(&proc_info::cpu_p); break;
+			case 7: sorter(&proc_info::cpu_c); break;
+			case 8: sorter([](const proc_info& p) { return p.net_rx + p.net_tx; }); break;
+		}
+	}
+
+	//* Processes with names, commands and users like those of a busy server, cpu and memory values are random
+	vector<proc_info> make_procs(size_t count, std::mt19937& rand) {
+		vector<proc_info> procs(count);
+		std::uniform_real_distribution<double> cpu(0.0, 5.0);
+		std::uniform_int_distribution<uint64_t> mem(1 << 20, 1ull << 32);
+		for (size_t pid = 1; auto& p : procs) {
+			p.pid = pid;
+			p.ppid = pid / 8;
+			p.name = fmt::format("worker-{}", pid % 300);
+			p.cmd = fmt::format("/usr/lib/app/worker-{} --queue={} --id={}", pid % 300, pid % 13, pid);
+			p.user = fmt::format("user{}", pid % 20);
+			p.threads = 1 + pid % 64;
+			p.mem = mem(rand);
+			p.cpu_p = cpu(rand);
+			p.cpu_c = cpu(rand);
+			pid++;
+		}
+		return procs;
+	}
+
+	//* Give every process new cpu values and a few new memory values, like a regular update
+	void update(vector<proc_info>& procs, std::mt19937& rand) {
+		std::uniform_real_distribution<double> cpu(0.0, 5.0);
+		std::uniform_int_distribution<uint64_t> mem(1 << 20, 1ull << 32);
+		for (size_t i = 0; auto& p : procs) {
+			p.cpu_p = cpu(rand);
+			p.cpu_c = (p.cpu_c * 9 + p.cpu_p) / 10;
+			if (i++ % 16 == 0) p.mem = mem(rand);
+		}
+	}
+
+	//* Mean milliseconds of <sort> after each of <runs> updates of the same processes
+	template <typename F>
+	double sort_ms(vector<proc_info> procs, F sort, size_t runs = 10) {
+		std::mt19937 rand(1);
+		sort(procs);
+		double total{};
+		for (size_t i = 0; i < runs; i++) {
+			update(procs, rand);
+			const auto start = clock::now();
+			sort(procs);
+			total += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		}
+		return total / runs;
+	}
+
+	//* proc_sorter() against a std::stable_sort of whole proc_info entries, after updates with new cpu values
+	//* "rows" sorts only the first 100 rows as done when not in tree mode, tree generation is timed by the proc_tree benchmark
+	int proc_sort(const vector<string>& args) {
+		fmt::println("{:>8} {:>12} {:>16} {:>16} {:>16}", "pids", "sorting", "stable_sort ms", "proc_sorter ms", "100 rows ms");
+		for (const size_t count : Bench::sizes(args, {10'000, 50'000, 100'000})) {
+			std::mt19937 rand(count);
+			const auto procs = make_procs(count, rand);
+			for (const string sorting : {"cpu direct", "cpu lazy", "memory", "name", "command"}) {
+				const double before = sort_ms(procs, [&](auto& p) { stable_sorter(p, sorting, false); });
+				const double after = sort_ms(procs, [&](auto& p) { Proc::proc_sorter(p, sorting, false); });
+				const double rows = sort_ms(procs, [&](auto& p) { Proc::proc_sorter(p, sorting, false, false, 100); });
+				fmt::println("{:>8} {:>12} {:>16.2f} {:>16.2f} {:>16.2f}", count, sorting, before, after, rows);
+			}
+		}
+		return 0;
+	}
+
+	const bool registered = Bench::add("proc_sort", "Proc::proc_sorter() against sorting whole proc_info entries", proc_sort);
+}
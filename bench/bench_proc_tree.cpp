@@ -0,0 +1,130 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_config.hpp"
+#include "../src/btop_shared.hpp"
+
+namespace {
+	using clock = std::chrono::steady_clock;
+
+	//* Tree state of a process compared between a collapse done in place and a full update
+	struct tree_row {
+		size_t pid, tree_index, depth;
+		bool filtered, collapsed;
+		string prefix;
+		double cpu_c;
+		uint64_t mem;
+		size_t threads;
+
+		bool operator==(const tree_row& other) const {
+			return pid == other.pid and tree_index == other.tree_index and depth == other.depth and filtered == other.filtered
+				and collapsed == other.collapsed and prefix == other.prefix and mem == other.mem and threads == other.threads
+				and std::abs(cpu_c - other.cpu_c) <= 1e-9 * std::max(1.0, std::abs(cpu_c));
+		}
+	};
+
+	//* Shown processes in tree order followed by hidden processes ordered by pid, since the order of hidden processes isn't used
+	vector<tree_row> snapshot(const vector<Proc::proc_info>& procs) {
+		vector<tree_row> rows;
+		rows.reserve(procs.size());
+		for (const auto& p : procs) rows.push_back({p.pid, p.tree_index, p.depth, p.filtered, p.collapsed, p.prefix, p.cpu_c, p.mem, p.threads});
+		const auto hidden = std::ranges::find(rows, true, &tree_row::filtered);
+		std::sort(hidden, rows.end(), [](const tree_row& a, const tree_row& b) { return a.pid < b.pid; });
+		return rows;
+	}
+
+	//* Milliseconds to collapse and then expand <pid> with a no_update collect, averaged over <runs>
+	std::pair<double, double> toggle_ms(size_t pid, size_t runs = 5) {
+		double collapse{}, expand{};
+		for (size_t i = 0; i < runs; i++) {
+			Proc::collapse = pid;
+			auto start = clock::now();
+			Proc::collect(true);
+			collapse += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			Proc::expand = pid;
+			start = clock::now();
+			Proc::collect(true);
+			expand += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		}
+		return {collapse / runs, expand / runs};
+	}
+
+	//* Collapse and expand <pid> in place and compare the tree with the one generated by a full update with the same state
+	bool matches_update(size_t pid) {
+		bool same = true;
+		for (int* toggle : {&Proc::collapse, &Proc::expand}) {
+			*toggle = pid;
+			const auto toggled = snapshot(Proc::collect(true));
+			same = same and toggled == snapshot(Proc::collect(false));
+		}
+		return same;
+	}
+
+	//* Cost of collapsing and expanding a process in the tree against generating the whole tree
+	//* "large" toggles a child of the root holding 1/8 of all processes, "small" a process with only a few children
+	int proc_tree(const vector<string>& args) {
+		fmt::println("{:>8} {:>12} {:>14} {:>14} {:>14} {:>14} {:>8}", "pids", "generate ms", "large coll ms", "large exp ms", "small coll ms", "small exp ms", "same");
+		for (const size_t count : Bench::sizes(args, {10'000, 50'000, 100'000})) {
+			Bench::FakeProc proc(count);
+			Bench::use_proc(proc.path());
+			Config::set("proc_idle_refresh", 1);
+			Config::set("proc_sorting", string{"memory"});
+			Config::set("proc_tree", true);
+			Proc::collect(false);
+
+			//? A changed sorting generates the tree again without reading processes
+			double generate{};
+			for (const bool reverse : {true, false, true, false}) {
+				Config::set("proc_reversed", reverse);
+				const auto start = clock::now();
+				Proc::collect(true);
+				generate += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+			}
+			generate /= 4;
+
+			const size_t large = 1001, small = 1000 + (count - 2) / 8;
+			const auto [large_collapse, large_expand] = toggle_ms(large);
+			const auto [small_collapse, small_expand] = toggle_ms(small);
+
+			//? Also compared with sorting by fields that aren't summed and in reverse order
+			bool same = true;
+			for (const auto& sorting : {"memory", "cpu lazy", "threads", "name", "pid"}) {
+				for (const bool reverse : {false, true}) {
+					Config::set("proc_sorting", string{sorting});
+					Config::set("proc_reversed", reverse);
+					Proc::collect(true);
+					same = same and matches_update(large) and matches_update(small);
+				}
+			}
+
+			fmt::println("{:>8} {:>12.2f} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f} {:>8}", count, generate,
+				large_collapse, large_expand, small_collapse, small_expand, (same ? "yes" : "NO"));
+		}
+		Config::set("proc_tree", false);
+		return 0;
+	}
+
+	const bool registered = Bench::add("proc_tree", "Collapse and expand in the Proc::collect() tree against generating the whole tree", proc_tree);
+}
@@ -0,0 +1,110 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <fstream>
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_tools.hpp"
+
+namespace {
+	namespace fs = std::filesystem;
+	using Tools::FileReader;
+
+	//* Read every file in <paths> with a std::ifstream and extract whitespace separated words, as the collectors did before FileReader
+	size_t read_ifstream(const vector<string>& paths) {
+		size_t words = 0;
+		for (const auto& path : paths) {
+			std::ifstream file(path);
+			for (string word; file >> word;) words++;
+		}
+		return words;
+	}
+
+	//* Read every file in <paths> relative to <reader> and split it with next_token()
+	size_t read_filereader(const FileReader& reader, const vector<string>& paths) {
+		size_t words = 0;
+		for (const auto& path : paths) {
+			auto content = reader.read(path.c_str());
+			while (not Tools::next_token(content, " \t\n").empty()) words++;
+		}
+		return words;
+	}
+
+	//* Time both readers on <files> below <dir> and print ns and read syscalls per file
+	void compare(const string& source, const fs::path& dir, const vector<string>& files) {
+		if (files.empty()) return;
+		vector<string> absolute;
+		absolute.reserve(files.size());
+		for (const auto& file : files) absolute.push_back((dir / file).string());
+		const FileReader reader(dir);
+
+		size_t words_ifstream = 0, words_reader = 0;
+		const double ifstream_ns = Bench::time_ns([&] { words_ifstream = read_ifstream(absolute); });
+		const double reader_ns = Bench::time_ns([&] { words_reader = read_filereader(reader, files); });
+
+		//? Read syscalls counted over a single pass, reading /proc/self/io itself adds one to both
+		auto syscalls = Bench::read_syscalls();
+		read_ifstream(absolute);
+		const double ifstream_reads = (double)(Bench::read_syscalls() - syscalls - 1) / files.size();
+		syscalls = Bench::read_syscalls();
+		read_filereader(reader, files);
+		const double reader_reads = (double)(Bench::read_syscalls() - syscalls - 1) / files.size();
+
+		if (words_ifstream != words_reader)
+			fmt::println(stderr, "WARNING: {} words read with ifstream, {} with FileReader", words_ifstream, words_reader);
+
+		fmt::println("{:<20} {:>8} {:>14.0f} {:>14.0f} {:>16.2f} {:>16.2f}", source, files.size(),
+			ifstream_ns / files.size(), reader_ns / files.size(), ifstream_reads, reader_reads);
+	}
+
+	//* Per file cost of reading and tokenizing with a std::ifstream against Tools::FileReader
+	//* Runs on /proc/[pid]/stat and status of the synthetic /proc (tmpfs) at each size and of the real /proc
+	int reader(const vector<string>& args) {
+		fmt::println("{:<20} {:>8} {:>14} {:>14} {:>16} {:>16}", "files", "count", "ifstream ns", "reader ns", "ifstream reads", "reader reads");
+		for (const size_t count : Bench::sizes(args, {1'000, 10'000})) {
+			Bench::FakeProc proc(count);
+			vector<string> stat, status;
+			for (const auto& d : fs::directory_iterator(proc.path())) {
+				const string name = d.path().filename();
+				if (not isdigit(name.front())) continue;
+				stat.push_back(name + "/stat");
+				status.push_back(name + "/status");
+			}
+			compare("synthetic stat", proc.path(), stat);
+			compare("synthetic status", proc.path(), status);
+		}
+
+		vector<string> stat, status;
+		for (const auto& d : fs::directory_iterator("/proc")) {
+			const string name = d.path().filename();
+			if (not isdigit(name.front())) continue;
+			stat.push_back(name + "/stat");
+			status.push_back(name + "/status");
+		}
+		compare("/proc/[pid]/stat", "/proc", stat);
+		compare("/proc/[pid]/status", "/proc", status);
+		compare("/proc/stat", "/proc", vector<string>(100, "stat"));
+		compare("/proc/meminfo", "/proc", vector<string>(100, "meminfo"));
+		compare("/proc/cpuinfo", "/proc", vector<string>(100, "cpuinfo"));
+		return 0;
+	}
+
+	const bool registered = Bench::add("reader", "std::ifstream against Tools::FileReader, ns and read syscalls per file", reader);
+}
@@ -0,0 +1,108 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <fstream>
+#include <limits>
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_shared.hpp"
+
+//? Defined in src/linux/btop_collect.cpp
+namespace Mem {
+	bool zfs_collect_stats(disk_info& disk, bool pool_total);
+}
+
+namespace {
+	namespace fs = std::filesystem;
+	using std::numeric_limits, std::streamsize;
+
+	//* Write a pool kstat directory with <count> objset files and the other files zfs keeps next to them
+	fs::path make_pool(const fs::path& root, size_t count) {
+		const fs::path dir = root / "spl/kstat/zfs/tank";
+		fs::create_directories(dir);
+		for (const auto* file : {"io", "state", "txgs", "multihost", "reads", "dmu_tx_assign"})
+			Bench::write_file(dir / file, "0 1 0x01 1 80 0 0\nname type data\n");
+		for (size_t i = 0; i < count; i++) {
+			Bench::write_file(dir / fmt::format("objset-0x{:x}", 0x36 + i), fmt::format(
+				"{} 1 0x01 7 2160 5238785428 172694398364\n"
+				"name                            type data\n"
+				"dataset_name                    7    tank/data/set{}\n"
+				"writes                          4    {}\n"
+				"nwritten                        4    {}\n"
+				"reads                           4    {}\n"
+				"nread                           4    {}\n"
+				"nunlinks                        4    0\n"
+				"nunlinked                       4    0\n", 40 + i, i, 100 + i, 40960 * (i + 1), 200 + i, 81920 * (i + 1)));
+		}
+		return dir;
+	}
+
+	//* Pool totals by listing <dir> and parsing every objset file with an ifstream, as done before the kstat cache
+	//* Returns reads + writes, bytes written and bytes read
+	array<int64_t, 3> scan_totals(const fs::path& dir) {
+		array<int64_t, 3> totals{};
+		std::ifstream diskread;
+		for (const auto& file : fs::directory_iterator(dir)) {
+			if (not file.path().filename().string().starts_with("objset")) continue;
+			diskread.open(file.path());
+			if (diskread.good()) {
+				int64_t value;
+				for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
+				for (const size_t field : {0, 1, 0, 2}) {
+					diskread.ignore(numeric_limits<streamsize>::max(), '4');
+					diskread >> value;
+					totals[field] += value;
+				}
+			}
+			diskread.close();
+		}
+		return totals;
+	}
+
+	//* Pool totals read every update from a synthetic pool kstat directory, directory scan with ifstream against the kstat cache
+	//* The cache keeps at most 512 objset files open, the rest are opened for each read
+	int zfs_kstats(const vector<string>& args) {
+		fmt::println("{:>8} {:>12} {:>12} {:>18} {:>18} {:>6}", "objsets", "scan ms", "cached ms", "scan reads/update", "cached reads/upd.", "same");
+		for (const size_t count : Bench::sizes(args, {100, 1'000, 3'000, 10'000})) {
+			Bench::FakeProc proc(0);
+			const auto dir = make_pool(proc.path(), count);
+
+			Mem::disk_info disk;
+			disk.stat = dir;
+			array<int64_t, 3> scanned{};
+			const double scan = Bench::time_ns([&] { scanned = scan_totals(dir); }) / 1e6;
+			const double cached = Bench::time_ns([&] { Mem::zfs_collect_stats(disk, true); }) / 1e6;
+
+			auto syscalls = Bench::read_syscalls();
+			scan_totals(dir);
+			const auto scan_reads = Bench::read_syscalls() - syscalls - 1;
+			syscalls = Bench::read_syscalls();
+			Mem::zfs_collect_stats(disk, true);
+			const auto cached_reads = Bench::read_syscalls() - syscalls - 1;
+
+			//? disk.old_io holds the last totals as reads + writes, bytes written and bytes read
+			const bool same = (scanned[0] == disk.old_io[2] and scanned[1] == disk.old_io[1] and scanned[2] == disk.old_io[0]);
+			fmt::println("{:>8} {:>12.3f} {:>12.3f} {:>18} {:>18} {:>6}", count, scan, cached, scan_reads, cached_reads, (same ? "yes" : "NO"));
+		}
+		return 0;
+	}
+
+	const bool registered = Bench::add("zfs_kstats", "ZFS pool totals from a synthetic objset directory, directory scan against the kstat cache", zfs_kstats);
+}
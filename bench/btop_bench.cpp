@@ -0,0 +1,159 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Benchmarks for the Linux collectors, built with "make bench"
+//* Run "bin/btop_bench" to list benchmarks and "bin/btop_bench <name> [sizes...]" to run one
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <map>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "btop_bench.hpp"
+#include "../src/btop_config.hpp"
+#include "../src/btop_shared.hpp"
+#include "../src/btop_tools.hpp"
+
+//? Defined in src/linux/btop_collect.cpp, not exposed in btop_shared.hpp since only the Linux collector uses them
+namespace Shared {
+	extern std::filesystem::path procPath, passwd_path;
+	extern Tools::FileReader proc_dir;
+	extern long pageSize, clkTck;
+}
+
+namespace Bench {
+	namespace {
+		struct entry {
+			string description;
+			bench_fn run;
+		};
+
+		std::map<string, entry>& benchmarks() {
+			static std::map<string, entry> all;
+			return all;
+		}
+	}
+
+	bool add(const string& name, const string& description, bench_fn run) {
+		benchmarks().insert_or_assign(name, entry{description, std::move(run)});
+		return true;
+	}
+
+	vector<size_t> sizes(const vector<string>& args, const vector<size_t>& defaults) {
+		vector<size_t> out;
+		for (const auto& arg : args) {
+			if (Tools::isint(arg)) out.push_back(std::stoul(arg));
+		}
+		return (out.empty() ? defaults : out);
+	}
+
+	void write_file(const fs::path& path, const string& content) {
+		const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0 or write(fd, content.data(), content.size()) != (ssize_t)content.size()) {
+			if (fd >= 0) close(fd);
+			throw std::runtime_error("Failed to write " + path.string());
+		}
+		close(fd);
+	}
+
+	uint64_t read_syscalls() {
+		string io;
+		if (not Shared::proc_dir.read("/proc/self/io", io)) return 0;
+		const auto pos = io.find("syscr:");
+		return (pos == string::npos ? 0 : std::stoull(io.substr(pos + 6)));
+	}
+
+	FakeProc::FakeProc(size_t count, size_t fanout) : fanout(std::max((size_t)1, fanout)) {
+		const fs::path base = (fs::is_directory("/dev/shm") ? fs::path("/dev/shm") : fs::temp_directory_path());
+		root = base / fmt::format("btop_bench_proc_{}", getpid());
+		fs::remove_all(root);
+		fs::create_directories(root);
+
+		write_file(root / "stat", "cpu  4705 150 1120 16250 520 0 30 0 0 0\ncpu0 4705 150 1120 16250 520 0 30 0 0 0\n"
+								"intr 1000\nctxt 2000\nprocs_running 1\nprocs_blocked 0\n");
+		write_file(root / "uptime", "12345.67 23456.78\n");
+		write_file(root / "meminfo", "MemTotal:       16303492 kB\nMemFree:         8151746 kB\nMemAvailable:   12227619 kB\n");
+		write_file(root / "passwd", "root:x:0:0:root:/root:/bin/bash\nbench:x:1000:1000:bench:/home/bench:/bin/bash\n");
+
+		//? The destructor isn't called if the constructor throws
+		try {
+			while (count-- > 0) add();
+		}
+		catch (...) {
+			std::error_code ec;
+			fs::remove_all(root, ec);
+			throw;
+		}
+	}
+
+	FakeProc::~FakeProc() {
+		std::error_code ec;
+		fs::remove_all(root, ec);
+	}
+
+	size_t FakeProc::add() {
+		const size_t pid = next_pid++;
+		const size_t ppid = (pid == start_pid ? 1 : start_pid + (pid - start_pid - 1) / fanout);
+		const fs::path dir = root / std::to_string(pid);
+		fs::create_directory(dir);
+		write_file(dir / "comm", fmt::format("worker-{}\n", pid % 97));
+		write_file(dir / "status", fmt::format("Name:\tworker-{}\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t{}\nPid:\t{}\nPPid:\t{}\n"
+											"Uid:\t1000\t1000\t1000\t1000\nGid:\t1000\t1000\t1000\t1000\n", pid % 97, pid, pid, ppid));
+		write_file(dir / "cmdline", fmt::format("/usr/lib/bench/worker{}--queue{}--id={}", '\0', '\0', pid % 13, '\0', pid));
+		write_file(dir / "stat", fmt::format("{} (worker-{}) S {} {} {} 0 -1 4194560 1520 0 0 0 {} {} 0 0 20 0 1 0 {} 10485760 {} "
+											"18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0\n",
+											pid, pid % 97, ppid, pid, pid, pid % 500, pid % 50, 1000 + pid % 1000, 200 + pid % 2000));
+		write_file(dir / "statm", fmt::format("2560 {} 100 1 0 200 0\n", 200 + pid % 2000));
+		return pid;
+	}
+
+	void FakeProc::remove_oldest() {
+		if (first_pid >= next_pid) return;
+		fs::remove_all(root / std::to_string(first_pid++));
+	}
+
+	void use_proc(const fs::path& dir) {
+		Shared::procPath = dir;
+		if (not Shared::proc_dir.open_dir(dir)) throw std::runtime_error("Failed to open " + dir.string());
+		Shared::passwd_path = dir / "passwd";
+		Shared::coreCount = 1;
+		Shared::pageSize = 4096;
+		Shared::clkTck = 100;
+	}
+}
+
+int main(int argc, char **argv) {
+	const vector<string> args(argv + std::min(argc, 2), argv + argc);
+	const auto& all = Bench::benchmarks();
+
+	if (argc < 2 or not all.contains(argv[1])) {
+		fmt::println("usage: btop_bench <benchmark> [sizes...]\n\nbenchmarks:");
+		for (const auto& [name, bench] : all) fmt::println("  {:<16}{}", name, bench.description);
+		return (argc < 2 ? 0 : 1);
+	}
+
+	try {
+		return all.at(argv[1]).run(args);
+	}
+	catch (const std::exception& e) {
+		fmt::println(stderr, "ERROR: {}", e.what());
+		return 1;
+	}
+}
@@ -0,0 +1,82 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace Bench {
+	namespace fs = std::filesystem;
+
+	//* Benchmark entry point, gets the arguments after the benchmark name and returns the exit code
+	using bench_fn = std::function<int(const vector<string>& args)>;
+
+	//* Register benchmark <name>, returns true so registration can initialize a static in the file defining the benchmark
+	bool add(const string& name, const string& description, bench_fn run);
+
+	//* Numbers given in <args>, or <defaults> if there are none
+	vector<size_t> sizes(const vector<string>& args, const vector<size_t>& defaults);
+
+	//* Average nanoseconds per call of <fn> over <runs> calls, after one call that isn't timed
+	template <typename F>
+	double time_ns(F&& fn, size_t runs = 5) {
+		fn();
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < runs; i++) fn();
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / std::max((size_t)1, runs);
+	}
+
+	//* Write <content> to <path>, throws if the file couldn't be written
+	void write_file(const fs::path& path, const string& content);
+
+	//* Number of read syscalls made by this process so far, from "syscr" in /proc/self/io, 0 if not available
+	uint64_t read_syscalls();
+
+	//* Synthetic /proc with the system files read by the proc collector and a tree of processes with <count> pids
+	//* Pids start at 1000 and form a tree where every process has <fanout> children, the tree is removed on destruction
+	class FakeProc {
+		static constexpr size_t start_pid = 1000;
+		fs::path root;
+		size_t next_pid = start_pid;
+		size_t first_pid = start_pid;
+		size_t fanout;
+	public:
+		explicit FakeProc(size_t count, size_t fanout = 8);
+		~FakeProc();
+		FakeProc(const FakeProc&) = delete;
+		FakeProc& operator=(const FakeProc&) = delete;
+
+		const fs::path& path() const { return root; }
+
+		//* Add a process with the next free pid, its parent is picked the same way as for the initial processes
+		size_t add();
+
+		//* Remove the process with the lowest pid still present, simulating the oldest process exiting
+		void remove_oldest();
+	};
+
+	//* Point the Linux collectors at <dir> instead of /proc, and use <dir>/passwd for user names
+	void use_proc(const fs::path& dir);
+}
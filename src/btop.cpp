@@ -399,6 +399,7 @@ namespace Runner {
 
 	string debug_bg;
 	unordered_flat_map<string, array<uint64_t, 2>> debug_times;
+	size_t debug_proc_bytes{};
 
 	class MyNumPunct : public std::numpunct<char>
 	{
@@ -481,7 +482,7 @@ namespace Runner {
 			//! DEBUG stats
 			if (Global::debug) {
 				if (debug_bg.empty() or redraw)
-					Runner::debug_bg = Draw::createBox(2, 2, 33, 8, "", true, "μs");
+					Runner::debug_bg = Draw::createBox(2, 2, 33, 11, "", true, "μs");
 
 
 
@@ -567,7 +568,8 @@ namespace Runner {
 						if (Global::debug) debug_timer("proc", collect_begin);
 
 						//? Start collect
-						auto proc = Proc::collect(conf.no_update);
+						auto& proc = Proc::collect(conf.no_update);
+						if (Global::debug) debug_proc_bytes = Proc::memory_usage(proc);
 
 						if (Global::debug) debug_timer("proc", draw_begin);
 
@@ -645,6 +647,21 @@ namespace Runner {
 						"draw"_a = time_draw
 					);
 				}
+				output += fmt::format(loc, "{mvLD}{ub}{name:9.9} {read:>10L}/{total:<10L}",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"ub"_a = Fx::ub,
+					"name"_a = "pids read",
+					"read"_a = Proc::pids_read.load(),
+					"total"_a = Proc::numpids.load()
+				);
+				output += fmt::format("{mvLD}{name:9.9} {heap:>10} {blank:10}{mvLD}{name2:9.9} {pool:>10}/{ref:<10}",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "proc heap",
+					"heap"_a = floating_humanizer(debug_proc_bytes), "blank"_a = "",
+					"name2"_a = "strings",
+					"pool"_a = floating_humanizer(Proc::pooled_string::pool_bytes()),
+					"ref"_a = floating_humanizer(Proc::pooled_string::referenced_bytes())
+				);
 			}
 
 			//? If overlay isn't empty, print output without color and then print overlay on top
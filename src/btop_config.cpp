@@ -82,7 +82,7 @@ namespace Config {
 
 		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
 
-		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
+		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\" \"network\",\n"
 								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
 
 		{"proc_reversed",		"#* Reverse sorting order, True or False."},
@@ -97,6 +97,10 @@ namespace Config {
 
 		{"proc_mem_bytes", 		"#* Show process memory as bytes instead of percent."},
 
+		{"proc_net", 			"#* (Linux) Show tcp bandwidth (received + sent per second) for each process, sortable with the \"network\" sorting."},
+
+		{"proc_net_ms", 		"#* (Linux) Milliseconds between collections of per process network bandwidth, runs separately from the update timer."},
+
 		{"proc_cpu_graphs",     "#* Show cpu graph for each process."},
 
 		{"proc_info_smaps",		"#* Use /proc/[pid]/smaps for memory information in the process info box (very slow but more accurate)"},
@@ -105,6 +109,15 @@ namespace Config {
 
 		{"proc_filter_kernel",  "#* (Linux) Filter processes tied to the Linux kernel(similar behavior to htop)."},
 
+		{"proc_threads",		"#* (Linux) Number of extra threads used to read process information in parallel, 0 to disable.\n"
+								"#* Only useful on systems with many cores and thousands of processes."},
+
+		{"proc_idle_refresh",	"#* (Linux) Number of updates to spread refreshing of idle processes over, 1 to refresh all processes every update.\n"
+								"#* Shown, selected and recently active processes are always refreshed every update."},
+
+		{"proc_events",			"#* (Linux) Track process start and exit with kernel proc connector events instead of listing /proc every update.\n"
+								"#* Needs root or CAP_NET_ADMIN, falls back to listing /proc if not permitted."},
+
 		{"cpu_graph_upper", 	"#* Sets the CPU stat shown in upper half of the CPU graph, \"total\" is always available.\n"
 								"#* Select from a list of detected attributes from the options menu."},
 
@@ -136,6 +149,10 @@ namespace Config {
 
 		{"show_cpu_freq", 		"#* Show CPU frequency."},
 
+		{"show_core_freq", 		"#* (Linux) Show current frequency of each core next to its usage and a line with lowest, average and highest core frequency."},
+
+		{"core_freq_ms", 		"#* (Linux) Milliseconds between reads of per core frequencies, values are kept until the next read."},
+
 		{"clock_format", 		"#* Draw a clock at top of screen, formatting according to strftime, empty string to disable.\n"
 								"#* Special formatting: /host = hostname | /user = username | /uptime = system uptime"},
 
@@ -166,8 +183,13 @@ namespace Config {
 
 		{"disk_free_priv",		"#* Set to true to show available disk space for privileged users."},
 
+		{"disk_timeout_ms",		"#* (Linux) Milliseconds to wait for the usage of a mounted filesystem before showing its last known values as stale.\n"
+								"#* Hung network filesystems are retried with increasing delays, 10 to 10000."},
+
 		{"show_io_stat", 		"#* Toggles if io activity % (disk busy time) should be shown in regular disk usage view."},
 
+		{"show_io_ops", 		"#* (Linux) Toggles if read/write operations per second, average latency and queue depth should be shown in regular disk usage view."},
+
 		{"io_mode", 			"#* Toggles io mode for disks, showing big graphs for disk read/write speeds."},
 
 		{"io_graph_combined", 	"#* Set to True to show combined read/write io graphs in io mode."},
@@ -183,6 +205,12 @@ namespace Config {
 
 		{"net_sync", 			"#* Sync the auto scaling for download and upload to whichever currently has the highest scale."},
 
+		{"net_packets", 		"#* (Linux) Show packets per second in the network graphs instead of bytes, with errors and drops per second next to the graphs."},
+
+		{"net_connections", 	"#* (Linux) Show TCP connections with the highest throughput instead of the network graphs."},
+
+		{"net_protocols", 		"#* (Linux) Show TCP retransmits, resets, listen overflows, orphaned and TIME_WAIT sockets and UDP receive buffer errors instead of the network graphs."},
+
 		{"net_iface", 			"#* Starts with the Network Interface specified here."},
 
 		{"show_battery", 		"#* Show battery stats in top right if battery is present."},
@@ -231,10 +259,12 @@ namespace Config {
 		{"proc_gradient", true},
 		{"proc_per_core", false},
 		{"proc_mem_bytes", true},
+		{"proc_net", false},
 		{"proc_cpu_graphs", true},
 		{"proc_info_smaps", false},
 		{"proc_left", false},
 		{"proc_filter_kernel", false},
+		{"proc_events", false},
 		{"cpu_invert_lower", true},
 		{"cpu_single_graph", false},
 		{"cpu_bottom", false},
@@ -242,6 +272,7 @@ namespace Config {
 		{"check_temp", true},
 		{"show_coretemp", true},
 		{"show_cpu_freq", true},
+		{"show_core_freq", false},
 		{"background_update", true},
 		{"mem_graphs", true},
 		{"mem_below_net", false},
@@ -253,11 +284,15 @@ namespace Config {
 		{"use_fstab", true},
 		{"zfs_hide_datasets", false},
 		{"show_io_stat", true},
+		{"show_io_ops", false},
 		{"io_mode", false},
 		{"base_10_sizes", false},
 		{"io_graph_combined", false},
 		{"net_auto", true},
 		{"net_sync", true},
+		{"net_packets", false},
+		{"net_connections", false},
+		{"net_protocols", false},
 		{"show_battery", true},
 		{"vim_keys", false},
 		{"tty_mode", false},
@@ -279,6 +314,11 @@ namespace Config {
 		{"proc_start", 0},
 		{"proc_selected", 0},
 		{"proc_last_selected", 0},
+		{"proc_threads", 0},
+		{"proc_idle_refresh", 1},
+		{"disk_timeout_ms", 200},
+		{"proc_net_ms", 2000},
+		{"core_freq_ms", 2000},
 	};
 	unordered_flat_map<string, int> intsTmp;
 
@@ -393,6 +433,21 @@ namespace Config {
 		else if (name == "update_ms" and i_value > 86400000)
 			validError = "Config value update_ms set too high (>86400000).";
 
+		else if (name == "proc_threads" and (i_value < 0 or i_value > 256))
+			validError = "Config value proc_threads must be between 0 and 256.";
+
+		else if (name == "proc_idle_refresh" and (i_value < 1 or i_value > 100))
+			validError = "Config value proc_idle_refresh must be between 1 and 100.";
+
+		else if (name == "disk_timeout_ms" and (i_value < 10 or i_value > 10000))
+			validError = "Config value disk_timeout_ms must be between 10 and 10000.";
+
+		else if (name == "proc_net_ms" and (i_value < 500 or i_value > 60000))
+			validError = "Config value proc_net_ms must be between 500 and 60000.";
+
+		else if (name == "core_freq_ms" and (i_value < 100 or i_value > 60000))
+			validError = "Config value core_freq_ms must be between 100 and 60000.";
+
 		else
 			return true;
 
@@ -379,7 +379,8 @@ namespace Draw {
 	}
 
 	//* Graph class ------------------------------------------------------------------------------------------------------------>
-	void Graph::_create(const deque<long long>& data, int data_offset) {
+	template<typename Data>
+	void Graph::_create(const Data& data, int data_offset) {
 		bool mult = (data.size() - data_offset > 1);
 		const auto& graph_symbol = Symbols::graph_symbols.at(symbol + '_' + (invert ? "down" : "up"));
 		array<int, 2> result;
@@ -450,8 +451,9 @@ namespace Draw {
 
 	Graph::Graph() {}
 
+	template<typename T>
 	Graph::Graph(int width, int height, const string& color_gradient,
-				 const deque<long long>& data, const string& symbol,
+				 const RingBuffer<T>& data, const string& symbol,
 				 bool invert, bool no_zero, long long max_value, long long offset)
 	: width(width), height(height), color_gradient(color_gradient),
 	  invert(invert), no_zero(no_zero), offset(offset) {
@@ -478,9 +480,15 @@ namespace Draw {
 		this->_create(data, data_offset);
 	}
 
-	string& Graph::operator()(const deque<long long>& data, bool data_same) {
+	template<typename T>
+	string& Graph::operator()(const RingBuffer<T>& data, bool data_same) {
 		if (data_same) return out;
+		this->_advance();
+		this->_create(data, (int)data.size() - 1);
+		return out;
+	}
 
+	void Graph::_advance() {
 		//? Make room for new characters on graph
 		if (not tty_mode) current = not current;
 		for (const int& i : iota(0, height)) {
@@ -491,13 +499,24 @@ namespace Draw {
 			else if (graphs.at(current).at(i).at(0) == ' ') graphs.at(current).at(i).erase(0, 1);
 			else graphs.at(current).at(i).erase(0, 3);
 		}
-		this->_create(data, (int)data.size() - 1);
+	}
+
+	string& Graph::operator()(long long value, bool data_same) {
+		if (data_same) return out;
+		this->_advance();
+		this->_create(array<long long, 1>{value}, 0);
 		return out;
 	}
 
 	string& Graph::operator()() {
 		return out;
 	}
+
+	//? Graph history is kept as 8 bit percentages or as full width values
+	template Graph::Graph(int, int, const string&, const RingBuffer<uint8_t>&, const string&, bool, bool, long long, long long);
+	template Graph::Graph(int, int, const string&, const RingBuffer<long long>&, const string&, bool, bool, long long, long long);
+	template string& Graph::operator()(const RingBuffer<uint8_t>&, bool);
+	template string& Graph::operator()(const RingBuffer<long long>&, bool);
 	//*------------------------------------------------------------------------------------------------------------------------->
 
 }
@@ -514,6 +533,7 @@ namespace Cpu {
 	string box;
 	Draw::Graph graph_upper;
 	Draw::Graph graph_lower;
+	field graph_up_key = field::total, graph_lo_key = field::total;
 	Draw::Meter cpu_meter;
 	vector<Draw::Graph> core_graphs;
 	vector<Draw::Graph> temp_graphs;
@@ -524,6 +544,7 @@ namespace Cpu {
 		bool show_temps = (Config::getB("check_temp") and got_sensors);
 		auto single_graph = Config::getB("cpu_single_graph");
 		bool hide_cores = show_temps and (cpu_temp_only or not Config::getB("show_coretemp"));
+		const bool show_freq = (Config::getB("show_core_freq") and has_core_freq);
 		const int extra_width = (hide_cores ? max(6, 6 * b_column_size) : 0);
 		auto& graph_up_field = Config::getS("cpu_graph_upper");
 		auto& graph_lo_field = Config::getS("cpu_graph_lower");
@@ -535,7 +556,8 @@ namespace Cpu {
 		const string& title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
 		const string& title_right = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
 		static int bat_pos = 0, bat_len = 0;
-		if (cpu.cpu_percent.at("total").empty()
+		const auto ghz = [](long long mhz) { return fmt::format("{:.1f}", mhz / 1000.0); };
+		if (cpu.cpu_percent[field::total].empty()
 			or cpu.core_percent.at(0).empty()
 			or (show_temps and cpu.temp.at(0).empty())) return "";
 		string out;
@@ -562,13 +584,15 @@ namespace Cpu {
 			Input::mouse_mappings["+"] = {button_y, x + width - 5, 1, 2};
 
 			//? Graphs & meters
-			graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", cpu.cpu_percent.at(graph_up_field), graph_symbol, false, true};
+			graph_up_key = cpu.cpu_percent.key(graph_up_field);
+			graph_lo_key = cpu.cpu_percent.key(graph_lo_field);
+			graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", cpu.cpu_percent[graph_up_key], graph_symbol, false, true};
 			cpu_meter = Draw::Meter{b_width - (show_temps ? 23 - (b_column_size <= 1 and b_columns == 1 ? 6 : 0) : 11), "cpu"};
 			if (not single_graph) {
 				graph_lower = Draw::Graph{
 					x + width - b_width - 3,
 					graph_low_height, "cpu",
-					cpu.cpu_percent.at(graph_lo_field),
+					cpu.cpu_percent[graph_lo_key],
 					graph_symbol,
 					Config::getB("cpu_invert_lower"), true
 				};
@@ -641,9 +665,9 @@ namespace Cpu {
 
 		try {
 		//? Cpu graphs
-		out += Fx::ub + Mv::to(y + 1, x + 1) + graph_upper(cpu.cpu_percent.at(graph_up_field), (data_same or redraw));
+		out += Fx::ub + Mv::to(y + 1, x + 1) + graph_upper(cpu.cpu_percent[graph_up_key], (data_same or redraw));
 		if (not single_graph)
-			out += Mv::to( y + graph_up_height + 1 + (mid_line ? 1 : 0), x + 1) + graph_lower(cpu.cpu_percent.at(graph_lo_field), (data_same or redraw));
+			out += Mv::to( y + graph_up_height + 1 + (mid_line ? 1 : 0), x + 1) + graph_lower(cpu.cpu_percent[graph_lo_key], (data_same or redraw));
 
 		//? Uptime
 		if (Config::getB("show_uptime")) {
@@ -661,8 +685,8 @@ namespace Cpu {
 			out += Mv::to(b_y, b_x + b_width - 10) + Fx::ub + Theme::c("div_line") + Symbols::h_line * (7 - cpuHz.size())
 				+ Symbols::title_left + Fx::b + Theme::c("title") + cpuHz + Fx::ub + Theme::c("div_line") + Symbols::title_right;
 
-		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(cpu.cpu_percent.at("total").back())
-			+ Theme::g("cpu").at(clamp(cpu.cpu_percent.at("total").back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent.at("total").back()), 4) + Theme::c("main_fg") + '%';
+		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(cpu.cpu_percent[field::total].back())
+			+ Theme::g("cpu").at(clamp((long long)cpu.cpu_percent[field::total].back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent[field::total].back()), 4) + Theme::c("main_fg") + '%';
 		if (show_temps) {
 			const auto [temp, unit] = celsius_to(cpu.temp.at(0).back(), temp_scale);
 			const auto& temp_color = Theme::g("temp").at(clamp(cpu.temp.at(0).back() * 100 / cpu.temp_max, 0ll, 100ll));
@@ -685,9 +709,14 @@ namespace Cpu {
 				out += Theme::c("inactive_fg") + graph_bg * (5 * b_column_size + extra_width) + Mv::l(5 * b_column_size + extra_width)
 					+ core_graphs.at(n)(cpu.core_percent.at(n), data_same or redraw);
 
-			out += Theme::g("cpu").at(clamp(cpu.core_percent.at(n).back(), 0ll, 100ll));
+			out += Theme::g("cpu").at(clamp((long long)cpu.core_percent.at(n).back(), 0ll, 100ll));
 			out += rjust(to_string(cpu.core_percent.at(n).back()), (b_column_size < 2 ? 3 : 4)) + Theme::c("main_fg") + '%';
 
+			if (show_freq) {
+				const long long mhz = (cmp_greater(cpu.core_freq.size(), n) and not cpu.core_freq.at(n).empty() ? cpu.core_freq.at(n).back() : 0);
+				out += (mhz > 0 ? rjust(ghz(mhz), 4) : Theme::c("inactive_fg") + "   -" + Theme::c("main_fg"));
+			}
+
 			if (show_temps and not hide_cores) {
 				const auto [temp, unit] = celsius_to(cpu.temp.at(n+1).back(), temp_scale);
 				const auto& temp_color = Theme::g("temp").at(clamp(cpu.temp.at(n+1).back() * 100 / cpu.temp_max, 0ll, 100ll));
@@ -699,12 +728,30 @@ namespace Cpu {
 
 			out += Theme::c("div_line") + Symbols::v_line;
 
-			if ((++cy > ceil((double)Shared::coreCount / b_columns) or cy == b_height - 2) and n != Shared::coreCount - 1) {
+			if ((++cy > ceil((double)Shared::coreCount / b_columns) or cy == b_height - 2 - show_freq) and n != Shared::coreCount - 1) {
 				if (++cc >= b_columns) break;
 				cy = 1; cx = (b_width / b_columns) * cc;
 			}
 		}
 
+		//? Lowest, average and highest frequency of the online cores
+		if (show_freq and b_height > 4) {
+			long long lowest = 0, highest = 0, sum = 0, online = 0;
+			for (const auto& history : cpu.core_freq) {
+				if (history.empty() or history.back() <= 0) continue;
+				lowest = (online++ == 0 ? history.back() : min(lowest, history.back()));
+				highest = max(highest, history.back());
+				sum += history.back();
+			}
+			const string values = (online > 0 ? ghz(lowest) + '/' + ghz((sum + online / 2) / online) + '/' + ghz(highest) : "-");
+			string freq_str;
+			for (const auto& candidate : {"Freq min/avg/max: " + values + " GHz", "Freq: " + values + " GHz", "F " + values, values}) {
+				freq_str = candidate;
+				if (cmp_less_equal(freq_str.size(), b_width - 2)) break;
+			}
+			out += Mv::to(b_y + b_height - 3, b_x + 1) + Theme::c("main_fg") + ljust(freq_str, b_width - 2);
+		}
+
 		//? Load average
 		if (cy < b_height - 1 and cc <= b_columns) {
 			string lavg_pre;
@@ -749,8 +796,8 @@ namespace Mem {
 	int disks_io_half = 0;
 	bool shown = true, redraw = true;
 	string box;
-	unordered_flat_map<string, Draw::Meter> mem_meters;
-	unordered_flat_map<string, Draw::Graph> mem_graphs;
+	enum_array<field, Draw::Meter, field_names> mem_meters;
+	enum_array<field, Draw::Graph, field_names> mem_graphs;
 	unordered_flat_map<string, Draw::Meter> disk_meters_used;
 	unordered_flat_map<string, Draw::Meter> disk_meters_free;
 	unordered_flat_map<string, Draw::Graph> io_graphs;
@@ -762,6 +809,7 @@ namespace Mem {
 		auto swap_disk = Config::getB("swap_disk");
 		auto show_disks = Config::getB("show_disks");
 		auto show_io_stat = Config::getB("show_io_stat");
+		auto show_io_ops = Config::getB("show_io_ops");
 		auto io_mode = Config::getB("io_mode");
 		auto io_graph_combined = Config::getB("io_graph_combined");
 		auto use_graphs = Config::getB("mem_graphs");
@@ -775,26 +823,27 @@ namespace Mem {
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out += box;
-			mem_meters.clear();
-			mem_graphs.clear();
+			mem_meters = {};
+			mem_graphs = {};
 			disk_meters_free.clear();
 			disk_meters_used.clear();
 			io_graphs.clear();
 
 			//? Mem graphs and meters
-			for (const auto& name : mem_names) {
-
+			for (const auto name : mem_names) {
+				const string gradient{mem.percent.name(name)};
 				if (use_graphs)
-					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name, mem.percent.at(name), graph_symbol};
+					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, gradient, mem.percent[name], graph_symbol};
 				else
-					mem_meters[name] = Draw::Meter{mem_meter, name};
+					mem_meters[name] = Draw::Meter{mem_meter, gradient};
 			}
 			if (show_swap and has_swap) {
-				for (const auto& name : swap_names) {
+				for (const auto name : swap_names) {
+					const string gradient{mem.percent.name(name).substr(5)};
 					if (use_graphs)
-						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name.substr(5), mem.percent.at(name), graph_symbol};
+						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, gradient, mem.percent[name], graph_symbol};
 					else
-						mem_meters[name] = Draw::Meter{mem_meter, name.substr(5)};
+						mem_meters[name] = Draw::Meter{mem_meter, gradient};
 				}
 			}
 
@@ -829,7 +878,7 @@ namespace Mem {
 							//? Create one combined graph for IO read/write if enabled
 							long long speed = (custom_speeds.contains(name) ? custom_speeds.at(name) : 100) << 20;
 							if (io_graph_combined) {
-								deque<long long> combined(disk.io_read.size(), 0);
+								RingBuffer<long long> combined(disk.io_read.size(), 0);
 								rng::transform(disk.io_read, disk.io_write, combined.begin(), std::plus<long long>());
 								io_graphs[name] = Draw::Graph{
 									disks_width - (io_mode ? 0 : 6),
@@ -872,33 +921,33 @@ namespace Mem {
 		bool big_mem = mem_width > 21;
 
 		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
-		vector<string> comb_names (mem_names.begin(), mem_names.end());
-		if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_names.begin(), swap_names.end());
-		for (auto name : comb_names) {
+		const size_t comb_count = mem_names.size() + (show_swap and has_swap and not swap_disk ? swap_names.size() : 0);
+		for (size_t i = 0; i < comb_count; i++) {
+			const auto name = (i < mem_names.size() ? mem_names[i] : swap_names[i - mem_names.size()]);
 			if (cy > height - 4) break;
 			string title;
-			if (name == "swap_used") {
+			if (name == field::swap_used) {
 				if (cy > height - 5) break;
 				if (height - cy > 6) {
 					if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
 					cy += 1;
 				}
-				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(mem.stats.at("swap_total")), mem_width - 8)
+				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(mem.stats[field::swap_total]), mem_width - 8)
 					+ Theme::c("main_fg") + Fx::ub;
 				cy += 1;
 				title = "Used";
 			}
-			else if (name == "swap_free")
+			else if (name == field::swap_free)
 				title = "Free";
 
-			if (title.empty()) title = capitalize(name);
-			const string humanized = floating_humanizer(mem.stats.at(name));
+			if (title.empty()) title = capitalize(string(mem.stats.name(name)));
+			const string humanized = floating_humanizer(mem.stats[name]);
 			const int offset = max(0, divider.empty() ? 9 - (int)humanized.size() : 0);
-			const string graphics = (use_graphs ? mem_graphs.at(name)(mem.percent.at(name), redraw or data_same) : mem_meters.at(name)(mem.percent.at(name).back()));
+			const string graphics = (use_graphs ? mem_graphs[name](mem.percent[name], redraw or data_same) : mem_meters[name](mem.percent[name].back()));
 			if (mem_size > 2) {
 				out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
 					+ Mv::to(y+1+cy, x+cx + mem_width - 2 - humanized.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + humanized : trans(humanized))
-					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(mem.percent.at(name).back()) + "%", 4);
+					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(mem.percent[name].back()) + "%", 4);
 				cy += (graph_height == 0 ? 2 : graph_height + 1);
 			}
 			else {
@@ -924,7 +973,7 @@ namespace Mem {
 					const auto& disk = disks.at(mount);
 					if (disk.io_read.empty()) continue;
 					const string total = floating_humanizer(disk.total, not big_disk);
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - total.size())
+					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c(disk.stale ? "inactive_fg" : "title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - total.size())
 						+ trans(total) + Fx::ub;
 					if (big_disk) {
 						const string used_percent = to_string(disk.used_percent);
@@ -938,7 +987,7 @@ namespace Mem {
 						const string humanized = (disk.io_write.back() > 0 ? "▼"s : ""s) + (disk.io_read.back() > 0 ? "▲"s : ""s)
 												+ (comb_val > 0 ? Mv::r(1) + floating_humanizer(comb_val, true) : "RW");
 						if (disks_io_h == 1) out += Mv::to(y+1+cy, x+1+cx) + string(5, ' ');
-						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)({comb_val}, redraw or data_same)
+						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)(comb_val, redraw or data_same)
 							+ Mv::to(y+1+cy, x+1+cx) + Theme::c("main_fg") + humanized;
 						cy += disks_io_h;
 					}
@@ -965,27 +1014,33 @@ namespace Mem {
 					const string human_used = floating_humanizer(disk.used, not big_disk);
 					const string human_free = floating_humanizer(disk.free, not big_disk);
 
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - human_total.size())
+					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c(disk.stale ? "inactive_fg" : "title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - human_total.size())
 						+ trans(human_total) + Fx::ub + Theme::c("main_fg");
 					if (big_disk and not human_io.empty())
 						out += Mv::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)human_io.size() / 2) - 1) + hu_div + human_io + hu_div;
 					if (++cy > height - 3) break;
 					if (show_io_stat and io_graphs.contains(mount + "_activity")) {
-						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6) + Theme::g("available").at(clamp(disk.io_activity.back(), 50ll, 100ll))
+						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6) + Theme::g("available").at(clamp((long long)disk.io_activity.back(), 50ll, 100ll))
 							+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
 						if (not big_disk) out += Mv::to(y+1+cy, x+cx+1) + Theme::c("main_fg") + human_io;
 						if (++cy > height - 3) break;
 					}
+					if (show_io_ops and disk.has_ops) {
+						const auto ops = [](double value) { return value < 10'000 ? fmt::format("{:.0f}", value) : fmt::format("{:.0f}k", value / 1000); };
+						out += Mv::to(y+1+cy, x+1+cx) + Theme::c("main_fg") + ljust((big_disk ? " Ops: ▲"s : "▲"s) + ops(disk.ops_read) + " ▼" + ops(disk.ops_write)
+							+ fmt::format(" {:.{}f}ms q{:.1f}", disk.await, (disk.await < 1.0 ? 2 : 1), disk.queue), disks_width, true);
+						if (++cy > height - 3) break;
+					}
 
 					out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " Used:" + rjust(to_string(disk.used_percent) + '%', 4) : "U") + ' '
 						+ disk_meters_used.at(mount)(disk.used_percent) + rjust(human_used, (big_disk ? 9 : 5));
 					if (++cy > height - 3) break;
 
-					if (cmp_less_equal(disks.size() * 3 + (show_io_stat ? disk_ios : 0), height - 1)) {
+					if (cmp_less_equal(disks.size() * 3 + (show_io_stat ? disk_ios : 0) + (show_io_ops ? disk_ios : 0), height - 1)) {
 						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " Free:" + rjust(to_string(disk.free_percent) + '%', 4) : "F") + ' '
 						+ disk_meters_free.at(mount)(disk.free_percent) + rjust(human_free, (big_disk ? 9 : 5));
 						cy++;
-						if (cmp_less_equal(disks.size() * 4 + (show_io_stat ? disk_ios : 0), height - 1)) cy++;
+						if (cmp_less_equal(disks.size() * 4 + (show_io_stat ? disk_ios : 0) + (show_io_ops ? disk_ios : 0), height - 1)) cy++;
 					}
 
 				}
@@ -1006,7 +1061,12 @@ namespace Net {
 	int b_x, b_y, b_width, b_height, d_graph_height, u_graph_height;
 	bool shown = true, redraw = true;
 	string old_ip;
-	unordered_flat_map<string, Draw::Graph> graphs;
+	bool old_packets{};  // defaults to false
+	bool old_connections{};  // defaults to false
+	bool old_protocols{};    // defaults to false
+	per_direction<Draw::Graph> graphs;
+	enum_array<protocol, Draw::Graph, protocol_names> proto_graphs;
+	enum_array<protocol, long long, protocol_names> proto_max;
 	string box;
 
 	string draw(const net_info& net, bool force_redraw, bool data_same) {
@@ -1021,34 +1081,54 @@ namespace Net {
 			old_ip = ip_addr;
 			redraw = true;
 		}
+		const bool packets = (Config::getB("net_packets") and not net.packets[direction::download].empty());
+		if (old_packets != packets) {
+			old_packets = packets;
+			redraw = true;
+		}
+		const bool connections_view = Config::getB("net_connections");
+		if (old_connections != connections_view) {
+			old_connections = connections_view;
+			redraw = true;
+		}
+		const bool protocols_view = (Config::getB("net_protocols") and not connections_view);
+		if (old_protocols != protocols_view) {
+			old_protocols = protocols_view;
+			redraw = true;
+		}
+		const auto& history = (packets ? net.packets : net.bandwidth);
+		const auto count = [](uint64_t value) {
+			if (value < 10'000) return to_string(value);
+			return (value < 10'000'000 ? fmt::format("{:.1f}k", value / 1e3) : fmt::format("{:.1f}M", value / 1e6));
+		};
 		string out;
 		out.reserve(width * height);
 		const string title_left = Theme::c("net_box") + Fx::ub + Symbols::title_left;
 		const string title_right = Theme::c("net_box") + Fx::ub + Symbols::title_right;
 		const int i_size = min((int)selected_iface.size(), 10);
-		const long long down_max = (net_auto ? graph_max.at("download") : ((long long)(Config::getI("net_download")) << 20) / 8);
-		const long long up_max = (net_auto ? graph_max.at("upload") : ((long long)(Config::getI("net_upload")) << 20) / 8);
+		const long long down_max = (packets ? packet_max[direction::download] : net_auto ? graph_max[direction::download] : ((long long)(Config::getI("net_download")) << 20) / 8);
+		const long long up_max = (packets ? packet_max[direction::upload] : net_auto ? graph_max[direction::upload] : ((long long)(Config::getI("net_upload")) << 20) / 8);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out = box;
 			//? Graphs
-			graphs.clear();
-			if (net.bandwidth.at("download").empty() or net.bandwidth.at("upload").empty())
+			graphs = {};
+			if (history[direction::download].empty() or history[direction::upload].empty())
 				return out + Fx::reset;
-			graphs["download"] = Draw::Graph{
+			graphs[direction::download] = Draw::Graph{
 				width - b_width - 2, u_graph_height, "download",
-				net.bandwidth.at("download"), graph_symbol,
+				history[direction::download], graph_symbol,
 				false, true, down_max};
-			graphs["upload"] = Draw::Graph{
+			graphs[direction::upload] = Draw::Graph{
 				width - b_width - 2, d_graph_height, "upload",
-				net.bandwidth.at("upload"), graph_symbol, true, true, up_max};
+				history[direction::upload], graph_symbol, true, true, up_max};
 
 			//? Interface selector and buttons
 
 			out += Mv::to(y, x+width - i_size - 9) + title_left + Fx::b + Theme::c("hi_fg") + "<b " + Theme::c("title")
 				+ uresize(selected_iface, 10) + Theme::c("hi_fg") + " n>" + title_right
-				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c("hi_fg") + (net.stat.at("download").offset + net.stat.at("upload").offset > 0 ? Fx::b : "") + 'z'
+				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c("hi_fg") + (net.stat[direction::download].offset + net.stat[direction::upload].offset > 0 ? Fx::b : "") + 'z'
 				+ Theme::c("title") + "ero" + title_right;
 			Input::mouse_mappings["b"] = {y, x+width - i_size - 8, 1, 3};
 			Input::mouse_mappings["n"] = {y, x+width - 6, 1, 3};
@@ -1071,15 +1151,35 @@ namespace Net {
 
 		//? Graphs and stats
 		int cy = 0;
-		for (const string dir : {"download", "upload"}) {
-			out += Mv::to(y+1 + (dir == "upload" ? u_graph_height : 0), x + 1) + graphs.at(dir)(net.bandwidth.at(dir), redraw or data_same or not net.connected)
-				+ Mv::to(y+1 + (dir == "upload" ? height - 3: 0), x + 1) + Fx::ub + Theme::c("graph_text")
-				+ floating_humanizer((dir == "upload" ? up_max : down_max), true);
-			const string speed = floating_humanizer(net.stat.at(dir).speed, false, 0, false, true);
-			const string speed_bits = (b_width >= 20 ? floating_humanizer(net.stat.at(dir).speed, false, 0, true, true) : "");
-			const string top = floating_humanizer(net.stat.at(dir).top, false, 0, true, true);
-			const string total = floating_humanizer(net.stat.at(dir).total);
-			const string symbol = (dir == "upload" ? "▲" : "▼");
+		for (const auto dir : directions) {
+			const bool upload = (dir == direction::upload);
+			const long long graph_max = (upload ? up_max : down_max);
+			if (not connections_view and not protocols_view)
+				out += Mv::to(y+1 + (upload ? u_graph_height : 0), x + 1) + graphs[dir](history[dir], redraw or data_same or not net.connected)
+					+ Mv::to(y+1 + (upload ? height - 3: 0), x + 1) + Fx::ub + Theme::c("graph_text")
+					+ (packets ? ljust(count(graph_max) + "/s", 10) : floating_humanizer(graph_max, true));
+			const string symbol = (upload ? "▲" : "▼");
+			if (packets) {
+				//? Packets per second with total packets, and errors and drops per second which are shown first on small boxes
+				const string speed = count(net.packet_stat[dir].speed) + " pkt/s";
+				const string faults = "Err: " + count(net.error_stat[dir].speed) + " Drop: " + count(net.drop_stat[dir].speed);
+				out += Mv::to(b_y+1+cy, b_x+1) + Fx::ub + Theme::c("main_fg") + symbol + ' ' + ljust(speed, b_width - 4);
+				cy += (b_height == 5 ? 2 : 1);
+				if (b_height >= 8) {
+					out += Mv::to(b_y+1+cy, b_x+1) + symbol + ' ' + "Total: " + rjust(count(net.packet_stat[dir].total), (b_width >= 20 ? 16 : 8));
+					cy++;
+				}
+				if (b_height >= 6) {
+					out += Mv::to(b_y+1+cy, b_x+1) + symbol + ' ' + (net.error_stat[dir].speed + net.drop_stat[dir].speed > 0 ? Theme::c("hi_fg") : "")
+						+ ljust(faults, b_width - 4, true) + Theme::c("main_fg");
+					cy += (b_height > 6 and b_height % 2 ? 2 : 1);
+				}
+				continue;
+			}
+			const string speed = floating_humanizer(net.stat[dir].speed, false, 0, false, true);
+			const string speed_bits = (b_width >= 20 ? floating_humanizer(net.stat[dir].speed, false, 0, true, true) : "");
+			const string top = floating_humanizer(net.stat[dir].top, false, 0, true, true);
+			const string total = floating_humanizer(net.stat[dir].total);
 			out += Mv::to(b_y+1+cy, b_x+1) + Fx::ub + Theme::c("main_fg") + symbol + ' ' + ljust(speed, 10) + (b_width >= 20 ? rjust('(' + speed_bits + ')', 13) : "");
 			cy += (b_height == 5 ? 2 : 1);
 			if (b_height >= 8) {
@@ -1092,6 +1192,65 @@ namespace Net {
 			}
 		}
 
+		//? TCP connections with the highest throughput in place of the graphs
+		if (connections_view) {
+			const int list_width = width - b_width - 2;
+			const bool wide = list_width >= 52;
+			const int name_width = 12, rate_width = 7;
+			const int remote_width = max(0, list_width - name_width - rate_width * 2 - (wide ? 12 : 0) - 2);
+			const string title = fmt::format("Remote ({} tcp):", connection_count);
+			out += Mv::to(y+1, x+1) + Fx::ub + Theme::c("title") + Fx::b + ljust("Program:", name_width) + ' ' + ljust(title, remote_width) + ' '
+				+ rjust("Rx/s", rate_width) + rjust("Tx/s", rate_width) + (wide ? rjust("Rtt", 7) + rjust("Retr", 5) : "") + Fx::ub + Theme::c("main_fg");
+			for (int i = 0; i < height - 3; i++) {
+				out += Mv::to(y+2+i, x+1);
+				if (cmp_less(i, connections.size())) {
+					const auto& conn = connections[i];
+					out += ljust((conn.name.empty() ? (conn.pid > 0 ? to_string(conn.pid) : "-"s) : conn.name), name_width, true) + ' '
+						+ ljust(conn.remote, remote_width, true) + ' '
+						+ rjust(floating_humanizer(conn.rx_rate, true), rate_width) + rjust(floating_humanizer(conn.tx_rate, true), rate_width)
+						+ (wide ? rjust(fmt::format("{:.1f}", conn.rtt / 1000.0), 7) + rjust(to_string(conn.retrans), 5) : "");
+				}
+				else out += string(list_width, ' ');
+			}
+		}
+
+		//? Protocol counters with a graph each in place of the network graphs
+		if (protocols_view) {
+			static const array<std::pair<protocol, string>, 6> fields = {{
+				{protocol::retrans, "Tcp retrans/s:"}, {protocol::resets, "Tcp resets/s:"}, {protocol::listen_overflows, "Listen ovfl/s:"},
+				{protocol::orphans, "Orphan sockets:"}, {protocol::time_wait, "TIME_WAIT:"}, {protocol::udp_rcvbuf_errors, "Udp rcvbuf err/s:"}
+			}};
+			const int list_width = width - b_width - 2, label_width = 18, value_width = 8;
+			const int graph_width = list_width - label_width - value_width - 1;
+			int cy = 0;
+			for (const auto& [name, label] : fields) {
+				if (cy >= height - 2) break;
+				out += Mv::to(y+1+cy++, x+1) + Theme::c("title") + ljust(label, label_width) + Theme::c("main_fg");
+				const auto& history = protocols[name];
+				if (history.empty()) {
+					out += string(list_width - label_width, ' ');
+					continue;
+				}
+				out += rjust(count(history.back()), value_width) + ' ';
+				if (graph_width < 5) continue;
+
+				//? Graphs scale to the highest value in history and are created again when the scale changes, a zero scale means not created yet
+				const long long peak = max(10ll, *rng::max_element(history));
+				auto& scale = proto_max[name];
+				bool rebuild = redraw;
+				if (peak > scale or peak * 4 < scale) {
+					scale = peak * 13 / 10;
+					rebuild = true;
+				}
+				if (rebuild) {
+					proto_graphs[name] = Draw::Graph{graph_width, 1, "upload", history, graph_symbol, false, false, scale};
+					out += proto_graphs[name]();
+				}
+				else out += proto_graphs[name](history, data_same);
+			}
+			while (cy < height - 2) out += Mv::to(y+1+cy++, x+1) + string(list_width, ' ');
+		}
+
 		redraw = false;
 		return out + Fx::reset;
 	}
@@ -1113,7 +1272,7 @@ namespace Proc {
 	Draw::TextEdit filter;
 	Draw::Graph detailed_cpu_graph;
 	Draw::Graph detailed_mem_graph;
-	int user_size, thread_size, prog_size, cmd_size, tree_size;
+	int user_size, thread_size, prog_size, cmd_size, tree_size, net_size;
 	int dgraph_x, dgraph_width, d_width, d_x, d_y;
 
 	string box;
@@ -1217,6 +1376,9 @@ namespace Proc {
 			prog_size = (width > 70 ? 16 : ( width > 55 ? 8 : width - user_size - thread_size - 33));
 			cmd_size = (width > 55 ? width - prog_size - user_size - thread_size - 33 : -1);
 			tree_size = width - user_size - thread_size - 23;
+			net_size = (Config::getB("proc_net") and width >= 60 ? 7 : 0);
+			cmd_size -= net_size;
+			tree_size -= net_size;
 			if (not show_graphs) {
 				cmd_size += 5;
 				tree_size += 5;
@@ -1370,6 +1532,7 @@ namespace Proc {
 
 			out += (thread_size > 0 ? Mv::l(4) + "Threads: " : "")
 					+ ljust("User:", user_size) + ' '
+					+ (net_size > 0 ? rjust("Net/s", net_size - 1) + ' ' : "")
 					+ rjust((mem_bytes ? "MemB" : "Mem%"), 5) + ' '
 					+ rjust("Cpu%", (show_graphs ? 10 : 5)) + Fx::ub;
 		}
@@ -1439,7 +1602,7 @@ namespace Proc {
 			bool has_graph = show_graphs ? p_counters.contains(p.pid) : false;
 			if (show_graphs and ((p.cpu_p > 0 and not has_graph) or (not data_same and has_graph))) {
 				if (not has_graph) {
-					p_graphs[p.pid] = Draw::Graph{5, 1, "", {}, graph_symbol};
+					p_graphs[p.pid] = Draw::Graph{5, 1, "", RingBuffer<long long>{}, graph_symbol};
 					p_counters[p.pid] = 0;
 				}
 				else if (p.cpu_p < 0.1 and ++p_counters[p.pid] >= 10) {
@@ -1505,7 +1668,7 @@ namespace Proc {
 				}
 				if (width_left > 7) {
 					const string& cmd = width_left > 40 ? rtrim(p.cmd) : p.short_cmd;
-					if (not cmd.empty() and cmd != p.name) {
+					if (not cmd.empty() and cmd != p.name.str()) {
 						out += g_color + '(' + uresize(cmd, width_left - 3, p_wide_cmd[p.pid]) + ") ";
 						width_left -= (ulen(cmd, true) + 3);
 					}
@@ -1530,10 +1693,11 @@ namespace Proc {
 				mem_str += '%';
 			}
 			out += (thread_size > 0 ? t_color + rjust(to_string(min(p.threads, (size_t)9999)), thread_size) + ' ' + end : "" )
-				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
+				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.str().substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
+				+ (net_size > 0 ? rjust(floating_humanizer(p.net_rx + p.net_tx, true), net_size - 1) + ' ' : "")
 				+ m_color + rjust(mem_str, 5) + end + ' '
 				+ (is_selected ? "" : Theme::c("inactive_fg")) + (show_graphs ? graph_bg * 5: "")
-				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
+				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)((p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p)), data_same) : "") + end + ' '
 				+ c_color + rjust(cpu_str, 4) + "  " + end;
 			if (lc++ > height - 5) break;
 		}
@@ -1627,30 +1791,31 @@ namespace Draw {
 		if (Cpu::shown) {
 			using namespace Cpu;
 			bool show_temp = (Config::getB("check_temp") and got_sensors);
+			bool show_freq = (Config::getB("show_core_freq") and has_core_freq);
 			width = round((double)Term::width * width_p / 100);
 			height = max(8, (int)ceil((double)Term::height * (trim(boxes) == "cpu" ? 100 : height_p) / 100));
 			x = 1;
 			y = cpu_bottom ? Term::height - height + 1 : 1;
 
-			b_columns = max(1, (int)ceil((double)(Shared::coreCount + 1) / (height - 5)));
-			if (b_columns * (21 + 12 * show_temp) < width - (width / 3)) {
+			b_columns = max(1, (int)ceil((double)(Shared::coreCount + 1) / (height - 5 - show_freq)));
+			if (b_columns * (21 + 12 * show_temp + 4 * show_freq) < width - (width / 3)) {
 				b_column_size = 2;
-				b_width = (21 + 12 * show_temp) * b_columns - (b_columns - 1);
+				b_width = (21 + 12 * show_temp + 4 * show_freq) * b_columns - (b_columns - 1);
 			}
-			else if (b_columns * (15 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (15 + 6 * show_temp + 4 * show_freq) < width - (width / 3)) {
 				b_column_size = 1;
-				b_width = (15 + 6 * show_temp) * b_columns - (b_columns - 1);
+				b_width = (15 + 6 * show_temp + 4 * show_freq) * b_columns - (b_columns - 1);
 			}
-			else if (b_columns * (8 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (8 + 6 * show_temp + 4 * show_freq) < width - (width / 3)) {
 				b_column_size = 0;
 			}
 			else {
-				b_columns = (width - width / 3) / (8 + 6 * show_temp);
+				b_columns = (width - width / 3) / (8 + 6 * show_temp + 4 * show_freq);
 				b_column_size = 0;
 			}
 
-			if (b_column_size == 0) b_width = (8 + 6 * show_temp) * b_columns + 1;
-			b_height = min(height - 2, (int)ceil((double)Shared::coreCount / b_columns) + 4);
+			if (b_column_size == 0) b_width = (8 + 6 * show_temp + 4 * show_freq) * b_columns + 1;
+			b_height = min(height - 2, (int)ceil((double)Shared::coreCount / b_columns) + 4 + show_freq);
 
 			b_x = x + width - b_width - 1;
 			b_y = y + ceil((double)(height - 2) / 2) - ceil((double)b_height / 2) + 1;
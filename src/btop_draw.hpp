@@ -22,13 +22,14 @@ tab-size = 4
 #include <vector>
 #include <array>
 #include <robin_hood.h>
-#include <deque>
+
+#include "btop_tools.hpp"
 
 using robin_hood::unordered_flat_map;
 using std::array;
-using std::deque;
 using std::string;
 using std::vector;
+using Tools::RingBuffer;
 
 namespace Symbols {
 	const string h_line				= "─";
@@ -111,19 +112,28 @@ namespace Draw {
 		unordered_flat_map<bool, vector<string>> graphs = { {true, {}}, {false, {}}};
 
 		//* Create two representations of the graph to switch between to represent two values for each braille character
-		void _create(const deque<long long>& data, int data_offset);
+		template<typename Data>
+		void _create(const Data& data, int data_offset);
+
+		//* Shift both representations one step to the left to make room for a new value
+		void _advance();
 
 	public:
 		Graph();
+		template<typename T>
 		Graph(int width, int height,
 			const string& color_gradient,
-			const deque<long long>& data,
+			const RingBuffer<T>& data,
 			const string& symbol="default",
 			bool invert=false, bool no_zero=false,
 			long long max_value=0, long long offset=0);
 
 		//* Add last value from back of <data> and return string representation of graph
-		string& operator()(const deque<long long>& data, bool data_same=false);
+		template<typename T>
+		string& operator()(const RingBuffer<T>& data, bool data_same=false);
+
+		//* Add <value> and return string representation of graph, for graphs without a kept history
+		string& operator()(long long value, bool data_same=false);
 
 		//* Return string representation of graph
 		string& operator()();
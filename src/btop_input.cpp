@@ -413,7 +413,6 @@ namespace Input {
 					auto& pid = Config::getI("selected_pid");
 					if (key == "+" or key == "space") Proc::expand = pid;
 					if (key == "-" or key == "space") Proc::collapse = pid;
-					no_update = false;
 				}
 				else if (is_in(key, "t", kill_key) and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
 					atomic_wait(Runner::active);
@@ -526,16 +525,29 @@ namespace Input {
 					Config::flip("net_auto");
 					Net::rescale = true;
 				}
+				else if (key == "x") {
+					Config::flip("net_packets");
+				}
+				else if (key == "w") {
+					Config::flip("net_connections");
+					Config::set("net_protocols", false);
+					no_update = false;
+				}
+				else if (key == "v") {
+					Config::flip("net_protocols");
+					Config::set("net_connections", false);
+					no_update = false;
+				}
 				else if (key == "z") {
 					atomic_wait(Runner::active);
 					auto& ndev = Net::current_net.at(Net::selected_iface);
-					if (ndev.stat.at("download").offset + ndev.stat.at("upload").offset > 0) {
-						ndev.stat.at("download").offset = 0;
-						ndev.stat.at("upload").offset = 0;
+					if (ndev.stat[Net::direction::download].offset + ndev.stat[Net::direction::upload].offset > 0) {
+						ndev.stat[Net::direction::download].offset = 0;
+						ndev.stat[Net::direction::upload].offset = 0;
 					}
 					else {
-						ndev.stat.at("download").offset = ndev.stat.at("download").last + ndev.stat.at("download").rollover;
-						ndev.stat.at("upload").offset = ndev.stat.at("upload").last + ndev.stat.at("upload").rollover;
+						ndev.stat[Net::direction::download].offset = ndev.stat[Net::direction::download].last + ndev.stat[Net::direction::download].rollover;
+						ndev.stat[Net::direction::upload].offset = ndev.stat[Net::direction::upload].last + ndev.stat[Net::direction::upload].rollover;
 					}
 					no_update = false;
 				}
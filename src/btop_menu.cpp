@@ -132,7 +132,11 @@ namespace Menu {
 		{"z", "Toggle totals reset for current network device"},
 		{"a", "Toggle auto scaling for the network graphs."},
 		{"y", "Toggle synced scaling mode for network graphs."},
+		{"x", "Toggle packets or bytes in network graphs."},
+		{"w", "Toggle TCP connections view in network box."},
+		{"v", "Toggle protocol counters view in network box."},
 		{"f, /", "To enter a process filter."},
+		{"", "Filter terms: user:name cpu>5 mem>1G !text"},
 		{"delete", "Clear any entered filter."},
 		{"c", "Toggle per-core cpu usage of processes."},
 		{"r", "Reverse sorting order in processes box."},
@@ -391,6 +395,25 @@ namespace Menu {
 				"",
 				"Can cause slowdowns on systems with many",
 				"cores and certain kernel versions."},
+			{"show_core_freq",
+				"(Linux) Show frequency of each core.",
+				"",
+				"Shows current frequency in GHz next to the",
+				"usage of each core and a line with lowest,",
+				"average and highest core frequency.",
+				"",
+				"Needs cpufreq support in the kernel.",
+				"",
+				"True or False."},
+			{"core_freq_ms",
+				"(Linux) Core frequency update interval.",
+				"",
+				"Milliseconds between reads of the",
+				"frequency of each core, values are kept",
+				"until the next read.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 60000 ms"},
 			{"custom_cpu_name",
 				"Custom cpu model name in cpu percentage box.",
 				"",
@@ -429,6 +452,14 @@ namespace Menu {
 				"(disk busy time) when not in IO mode.",
 				"",
 				"True or False."},
+			{"show_io_ops",
+				"(Linux) Toggle disk operation stats.",
+				"",
+				"Show read/write operations per second,",
+				"average time per operation (await) and",
+				"average queue depth when not in IO mode.",
+				"",
+				"True or False."},
 			{"io_mode",
 				"Toggles io mode for disks.",
 				"",
@@ -492,6 +523,17 @@ namespace Menu {
 				"",
 				"Set to false to show available for normal",
 				"users."},
+			{"disk_timeout_ms",
+				"(Linux) Disk usage timeout in milliseconds.",
+				"",
+				"Time to wait for the usage of a mounted",
+				"filesystem before its last known values",
+				"are shown as stale (dimmed name).",
+				"",
+				"Hung network filesystems are retried with",
+				"increasing delays.",
+				"",
+				"Min value: 10, max value: 10000."},
 			{"disks_filter",
 				"Optional filter for shown disks.",
 				"",
@@ -548,6 +590,39 @@ namespace Menu {
 				"whichever currently has the highest scale.",
 				"",
 				"True or False."},
+			{"net_packets",
+				"(Linux) Show packets in network graphs.",
+				"",
+				"Graphs packets per second instead of bytes",
+				"and shows errors and drops per second next",
+				"to the graphs. Packet graphs always auto scale.",
+				"",
+				"Can be toggled with the x key.",
+				"",
+				"True or False."},
+			{"net_connections",
+				"(Linux) Show TCP connections in network box.",
+				"",
+				"Lists the TCP connections with the highest",
+				"throughput instead of the network graphs,",
+				"with round trip time, retransmitted segments",
+				"and the program owning the connection.",
+				"",
+				"Can be toggled with the w key.",
+				"",
+				"True or False."},
+			{"net_protocols",
+				"(Linux) Show protocol counters in net box.",
+				"",
+				"Shows TCP retransmits, resets and listen",
+				"overflows per second, orphaned and TIME_WAIT",
+				"sockets and UDP receive buffer errors per",
+				"second with graphs, instead of the network",
+				"graphs.",
+				"",
+				"Can be toggled with the v key.",
+				"",
+				"True or False."},
 			{"net_iface",
 				"Network Interface.",
 				"",
@@ -573,8 +648,8 @@ namespace Menu {
 				"",
 				"Possible values:",
 				"\"pid\", \"program\", \"arguments\", \"threads\",",
-				"\"user\", \"memory\", \"cpu lazy\" and",
-				"\"cpu direct\".",
+				"\"user\", \"memory\", \"cpu lazy\",",
+				"\"cpu direct\" and \"network\".",
 				"",
 				"\"cpu lazy\" updates top process over time.",
 				"\"cpu direct\" updates top process",
@@ -613,6 +688,23 @@ namespace Menu {
 				" ",
 				"Will show percentage of total memory",
 				"if False."},
+			{"proc_net",
+				"(Linux) Show network usage per process.",
+				"",
+				"Adds a column with tcp bytes received and",
+				"sent per second, summed over the sockets",
+				"owned by each process.",
+				"",
+				"True or False."},
+			{"proc_net_ms",
+				"(Linux) Process network update interval.",
+				"",
+				"Milliseconds between collections of network",
+				"usage per process, runs on its own thread",
+				"separately from the update timer.",
+				"",
+				"Min value: 500 ms",
+				"Max value: 60000 ms"},
 			{"proc_cpu_graphs",
 				"Show cpu graph for each process.",
 				"",
@@ -622,6 +714,36 @@ namespace Menu {
 				"",
 				"Set to 'True' to filter out internal",
 				"processes started by the Linux kernel."},
+			{"proc_threads",
+				"(Linux) Parallel process collection.",
+				"",
+				"Number of extra threads used to read",
+				"process information from /proc.",
+				"",
+				"Only useful on systems with many cores",
+				"and thousands of processes.",
+				"",
+				"0 to disable, max value: 256."},
+			{"proc_idle_refresh",
+				"(Linux) Tiered process refresh.",
+				"",
+				"Number of updates to spread refreshing of",
+				"idle processes over.",
+				"",
+				"Shown, selected and recently active",
+				"processes are always refreshed.",
+				"",
+				"1 to refresh all processes every update,",
+				"max value: 100."},
+			{"proc_events",
+				"(Linux) Event driven process tracking.",
+				"",
+				"Use kernel proc connector events to track",
+				"started and exited processes instead of",
+				"listing /proc every update.",
+				"",
+				"Needs root or CAP_NET_ADMIN, falls back",
+				"to listing /proc if not permitted."},
 		}
 	};
 
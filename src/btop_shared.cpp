@@ -16,7 +16,15 @@ indent = tab
 tab-size = 4
 */
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
 #include <ranges>
+#include <string_view>
+#include <type_traits>
 
 #include "btop_shared.hpp"
 #include "btop_tools.hpp"
@@ -26,34 +34,350 @@ using namespace Tools;
 
 
 namespace Proc {
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree) {
-		if (reverse) {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::less{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::less{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::less{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::less{}, &proc_info::user);		break;
-			case 5: rng::stable_sort(proc_vec, rng::less{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_p);		break;
-			case 7: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_c);		break;
-			}
+	namespace {
+		//* Parse a number with an optional K, M, G or T suffix (1024 based), returns false if <str> isn't a valid number
+		bool parse_number(const string& str, double& value, bool allow_suffix) {
+			if (str.empty()) return false;
+			char* end = nullptr;
+			value = std::strtod(str.c_str(), &end);
+			if (end == str.c_str()) return false;
+			std::string_view suffix = end;
+			if (suffix.empty()) return true;
+			if (not allow_suffix) return false;
+			const auto unit = std::string_view{"kmgt"}.find(std::tolower(suffix.front()));
+			if (unit == std::string_view::npos) return false;
+			suffix.remove_prefix(1);
+			if (not suffix.empty() and suffix != "b" and suffix != "B" and suffix != "ib" and suffix != "iB") return false;
+			value *= std::pow(1024.0, unit + 1);
+			return true;
+		}
+
+		struct string_pool {
+			std::mutex lock;
+			unordered_flat_map<std::string_view, void*> index;
+			size_t stored{};
+			size_t referenced{};
+		};
+
+		//? Never destroyed since handles in static containers can be released after static destruction has started
+		string_pool& pool() {
+			static auto* str_pool = new string_pool;
+			return *str_pool;
+		}
+
+		const string empty_string{};
+
+		//* Heap bytes allocated by <str>, short strings are stored inline
+		size_t heap_size(const string& str) {
+			return str.capacity() > string{}.capacity() ? str.capacity() + 1 : 0;
+		}
+	}
+
+	void pooled_string::assign(std::string_view str) {
+		if (ptr != nullptr and ptr->str == str) return;
+		release();
+		if (str.empty()) return;
+		auto& sp = pool();
+		std::lock_guard lock(sp.lock);
+		if (auto found = sp.index.find(str); found != sp.index.end()) {
+			ptr = static_cast<entry*>(found->second);
+			ptr->refs++;
 		}
 		else {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::user); 		break;
-			case 5: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_p);   	break;
-			case 7: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_c);   	break;
+			ptr = new entry{string{str}, 1};
+			sp.index.emplace(ptr->str, ptr);
+			sp.stored += sizeof(entry) + heap_size(ptr->str);
+		}
+		sp.referenced += heap_size(ptr->str);
+	}
+
+	void pooled_string::acquire(entry* other) {
+		ptr = other;
+		if (ptr == nullptr) return;
+		auto& sp = pool();
+		std::lock_guard lock(sp.lock);
+		ptr->refs++;
+		sp.referenced += heap_size(ptr->str);
+	}
+
+	void pooled_string::release() {
+		if (ptr == nullptr) return;
+		auto& sp = pool();
+		std::lock_guard lock(sp.lock);
+		sp.referenced -= heap_size(ptr->str);
+		if (--ptr->refs == 0) {
+			sp.index.erase(std::string_view{ptr->str});
+			sp.stored -= sizeof(entry) + heap_size(ptr->str) + heap_size(ptr->lower);
+			delete ptr;
+		}
+		ptr = nullptr;
+	}
+
+	const string& pooled_string::str() const {
+		return ptr == nullptr ? empty_string : ptr->str;
+	}
+
+	const string& pooled_string::lower() const {
+		if (ptr == nullptr) return empty_string;
+		if (ptr->lower.empty()) {
+			string lower(ptr->str.size(), '\0');
+			rng::transform(ptr->str, lower.begin(), [](unsigned char c) { return (c >= 'A' and c <= 'Z') ? c + 32 : c; });
+			auto& sp = pool();
+			std::lock_guard lock(sp.lock);
+			sp.stored += heap_size(lower);
+			ptr->lower = std::move(lower);
+		}
+		return ptr->lower;
+	}
+
+	size_t pooled_string::pool_bytes() {
+		auto& sp = pool();
+		std::lock_guard lock(sp.lock);
+		return sp.stored + sp.index.calcNumBytesTotal(sp.index.mask() + 1);
+	}
+
+	size_t pooled_string::referenced_bytes() {
+		auto& sp = pool();
+		std::lock_guard lock(sp.lock);
+		return sp.referenced;
+	}
+
+	size_t memory_usage(const vector<proc_info>& procs) {
+		size_t bytes = procs.capacity() * sizeof(proc_info);
+		for (const auto& p : procs) {
+			for (const string* str : {&p.short_cmd, &p.prefix})
+				bytes += heap_size(*str);
+		}
+		return bytes + pooled_string::pool_bytes();
+	}
+
+	filter_matcher::filter_matcher(const string& filter) {
+		for (size_t pos = 0; pos < filter.size();) {
+			if (filter[pos] == ' ') {
+				pos++;
+				continue;
+			}
+			term t;
+			if (filter[pos] == '!') {
+				t.negate = true;
+				pos++;
+			}
+
+			//? Quoted terms are always plain text
+			bool quoted = false;
+			string text;
+			if (pos < filter.size() and filter[pos] == '"') {
+				const auto end = filter.find('"', pos + 1);
+				text = filter.substr(pos + 1, end == string::npos ? string::npos : end - pos - 1);
+				pos = (end == string::npos ? filter.size() : end + 1);
+				quoted = true;
 			}
+			else {
+				const auto end = filter.find(' ', pos);
+				text = filter.substr(pos, end == string::npos ? string::npos : end - pos);
+				pos = (end == string::npos ? filter.size() : end);
+			}
+			text = str_to_lower(text);
+
+			if (not quoted) {
+				//? Field limited text, "user:postgres"
+				if (const auto colon = text.find(':'); colon != string::npos and colon + 1 < text.size()) {
+					const auto name = text.substr(0, colon);
+					const field target = (name == "pid" ? field::pid : name == "name" ? field::name
+										: name == "cmd" ? field::cmd : name == "user" ? field::user : field::any);
+					if (target != field::any) {
+						t.target = target;
+						text.erase(0, colon + 1);
+					}
+				}
+				//? Numeric comparison, "cpu>5" or "mem>=1G"
+				else if (const auto op_pos = text.find_first_of("<>="); op_pos != string::npos) {
+					const auto name = text.substr(0, op_pos);
+					const field target = (name == "cpu" ? field::cpu : name == "mem" ? field::mem
+										: name == "threads" ? field::threads : field::any);
+					const bool equal = (op_pos + 1 < text.size() and text[op_pos + 1] == '=' and text[op_pos] != '=');
+					const auto op = (text[op_pos] == '>' ? (equal ? compare::greater_eq : compare::greater)
+									: text[op_pos] == '<' ? (equal ? compare::less_eq : compare::less) : compare::equal);
+					double value;
+					if (target != field::any and parse_number(text.substr(op_pos + 1 + equal), value, target == field::mem)) {
+						t.target = target;
+						t.op = op;
+						t.value = value;
+						terms.push_back(std::move(t));
+						continue;
+					}
+				}
+			}
+			//? Skip empty terms, a negated one from a lone ! or !"" would otherwise hide all processes
+			if (text.empty()) continue;
+			t.needle = std::move(text);
+			terms.push_back(std::move(t));
+		}
+	}
+
+	bool filter_matcher::term_match(const term& t, const proc_info& p) {
+		const auto contains = [&t](const string& str) {
+			return std::string_view{str}.find(t.needle) != std::string_view::npos;
+		};
+		const auto pid_contains = [&]() {
+			array<char, 24> buf;
+			const auto end = std::to_chars(buf.data(), buf.data() + buf.size(), p.pid).ptr;
+			return std::string_view(buf.data(), end - buf.data()).find(t.needle) != std::string_view::npos;
+		};
+		const auto numeric = [&t](const double val) {
+			switch (t.op) {
+				case compare::greater: return val > t.value;
+				case compare::less: return val < t.value;
+				case compare::greater_eq: return val >= t.value;
+				case compare::less_eq: return val <= t.value;
+				default: return val == t.value;
+			}
+		};
+
+		switch (t.target) {
+			case field::any:
+				return pid_contains() or contains(p.name.lower()) or contains(p.cmd.lower()) or contains(p.user.lower());
+			case field::pid: return pid_contains();
+			case field::name: return contains(p.name.lower());
+			case field::cmd: return contains(p.cmd.lower());
+			case field::user: return contains(p.user.lower());
+			case field::cpu: return numeric(p.cpu_p);
+			case field::mem: return numeric(p.mem);
+			case field::threads: return numeric(p.threads);
+		}
+		return false;
+	}
+
+	//* Sort key of a process copied out of proc_info, so sorting only moves small entries instead of whole proc_info's
+	//* String keys are referenced by pointer, numeric keys are stored by value
+	template <typename T>
+	struct sort_entry {
+		T key;
+		size_t pid;
+		uint32_t index;
+		bool filtered;
+		bool busy;      // above the "cpu lazy" threshold of 10% cpu usage
+	};
+
+	//? Most out of place entries moved by adaptive_sort before falling back to a full sort, each move can rotate the whole column
+	constexpr size_t max_moves = 16;
+
+	//* Return true if <column> likely only needs a few entries moved to be sorted according to <comp>
+	template <typename T, typename Comp>
+	bool nearly_sorted(const vector<T>& column, Comp comp) {
+		size_t descents = 0;
+		for (size_t i = 1; i < column.size(); i++) {
+			if (comp(column[i], column[i - 1]) and ++descents > max_moves) return false;
+		}
+		return true;
+	}
+
+	//* Insertion sort for input that is already nearly sorted, each out of place entry is moved to its position with a binary search
+	//* Returns false if more than max_moves entries are out of place, <column> is then left partially sorted for a full sort
+	template <typename T, typename Comp>
+	bool adaptive_sort(vector<T>& column, Comp comp) {
+		size_t moves = 0;
+		for (auto it = std::next(column.begin(), std::min((size_t)1, column.size())); it != column.end(); ++it) {
+			if (not comp(*it, *std::prev(it))) continue;
+			if (++moves > max_moves) return false;
+			auto pos = std::upper_bound(column.begin(), it, *it, comp);
+			std::rotate(pos, it, std::next(it));
+		}
+		return true;
+	}
+
+	size_t proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree, size_t rows) {
+		const int sort_index = v_index(sort_vector, sorting);
+		const bool lazy = (not tree and not reverse and sorting == "cpu lazy");
+
+		//* Order by selected field, ties are ordered by pid to give the same order regardless of sorting method
+		const auto pooled = [](pooled_string proc_info::* member) {
+			return [member](const proc_info& p) -> const string& { return (p.*member).str(); };
+		};
+
+		const auto sort_fn = [&](auto proj) {
+			using value_t = std::remove_cvref_t<std::invoke_result_t<decltype(proj), const proc_info&>>;
+			constexpr bool by_pointer = not std::is_arithmetic_v<value_t>;
+			using key_t = std::conditional_t<by_pointer, const value_t*, value_t>;
+			using entry_t = sort_entry<key_t>;
+
+			//? The column is kept between sorts, but not at more than twice the size needed
+			static vector<entry_t> column;
+			column.clear();
+			if (column.capacity() > 2 * proc_vec.size()) column.shrink_to_fit();
+			column.reserve(proc_vec.size());
+			for (uint32_t i = 0; auto& p : proc_vec) {
+				if constexpr (by_pointer) column.push_back({&std::invoke(proj, p), p.pid, i++, p.filtered, p.cpu_p > 10.0});
+				else column.push_back({std::invoke(proj, p), p.pid, i++, p.filtered, p.cpu_p > 10.0});
+			}
+
+			const auto comp = [&](const entry_t& a, const entry_t& b) {
+				//? Pooled strings are stored once, so equal strings point to the same key
+				if constexpr (by_pointer) if (a.key == b.key) return a.pid < b.pid;
+				const auto& a_val = [&]() -> const value_t& { if constexpr (by_pointer) return *a.key; else return a.key; }();
+				const auto& b_val = [&]() -> const value_t& { if constexpr (by_pointer) return *b.key; else return b.key; }();
+				if (a_val != b_val) return (reverse ? a_val < b_val : a_val > b_val);
+				return a.pid < b.pid;
+			};
+
+			//? Move processes hidden by the filter to the end since they are never shown
+			//? "cpu lazy" keeps them in place since they count towards its threshold, so more rows are sorted instead
+			auto shown_end = column.end();
+			if (lazy and rows > 0)
+				rows = std::max((size_t)7, rows) + rng::count(column, true, &entry_t::filtered);
+			else if (not tree and rows > 0)
+				shown_end = std::partition(column.begin(), column.end(), [](const entry_t& e) { return not e.filtered; });
+			const size_t shown = std::distance(column.begin(), shown_end);
+
+			size_t sorted = proc_vec.size();
+
+			//? Full sort if all rows are needed, using an insertion sort if only a few rows moved since last update
+			if (rows == 0 or rows >= shown) {
+				if (not nearly_sorted(column, comp) or not adaptive_sort(column, comp)) rng::sort(column, comp);
+			}
+			//? Otherwise select the first <rows> processes and only sort those
+			else {
+				auto rows_end = std::next(column.begin(), rows);
+				std::nth_element(column.begin(), rows_end, shown_end, comp);
+
+				//? "cpu lazy" can move processes above 10% cpu usage from anywhere in the list, so these are sorted together with the selected rows
+				if (lazy) rows_end = std::partition(rows_end, shown_end, [](const entry_t& e) { return e.busy; });
+
+				std::sort(column.begin(), rows_end, comp);
+				sorted = rows;
+			}
+
+			//? Move processes to their sorted position in place, following each cycle of the permutation moves every process once
+			for (uint32_t start = 0; start < column.size(); start++) {
+				if (column[start].index == start) continue;
+				proc_info moving = std::move(proc_vec[start]);
+				uint32_t to = start;
+				for (uint32_t from = column[to].index; from != start; from = column[to].index) {
+					proc_vec[to] = std::move(proc_vec[from]);
+					column[to].index = to;
+					to = from;
+				}
+				proc_vec[to] = std::move(moving);
+				column[to].index = to;
+			}
+			return sorted;
+		};
+
+		size_t sorted = proc_vec.size();
+		switch (sort_index) {
+			case 0: sorted = sort_fn(&proc_info::pid);				break;
+			case 1: sorted = sort_fn(pooled(&proc_info::name));	break;
+			case 2: sorted = sort_fn(pooled(&proc_info::cmd));		break;
+			case 3: sorted = sort_fn(&proc_info::threads);			break;
+			case 4: sorted = sort_fn(pooled(&proc_info::user));	break;
+			case 5: sorted = sort_fn(&proc_info::mem);				break;
+			case 6: sorted = sort_fn(&proc_info::cpu_p);			break;
+			case 7: sorted = sort_fn(&proc_info::cpu_c);			break;
+			case 8: sorted = sort_fn([](const proc_info& p) { return p.net_rx + p.net_tx; });	break;
 		}
 
 		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
-		if (not tree and not reverse and sorting == "cpu lazy") {
+		if (lazy) {
 			double max = 10.0, target = 30.0;
 			for (size_t i = 0, x = 0, offset = 0; i < proc_vec.size(); i++) {
 				if (i <= 5 and proc_vec.at(i).cpu_p > max)
@@ -68,6 +392,8 @@ namespace Proc {
 				}
 			}
 		}
+
+		return sorted;
 	}
 
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, int& c_index, const int index_max, bool collapsed) {
@@ -78,6 +404,7 @@ namespace Proc {
 				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem < b.entry.get().mem; });	break;
 				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p < b.entry.get().cpu_p; });	break;
 				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c < b.entry.get().cpu_c; });	break;
+				case 8: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().net_rx + a.entry.get().net_tx < b.entry.get().net_rx + b.entry.get().net_tx; });	break;
 				}
 			}
 			else {
@@ -86,6 +413,7 @@ namespace Proc {
 				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem > b.entry.get().mem; });	break;
 				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p > b.entry.get().cpu_p; });	break;
 				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c > b.entry.get().cpu_c; });	break;
+				case 8: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().net_rx + a.entry.get().net_tx > b.entry.get().net_rx + b.entry.get().net_tx; });	break;
 				}
 			}
 		}
@@ -99,16 +427,13 @@ namespace Proc {
 	}
 
 	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
-		int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter) {
+		int cur_depth, bool collapsed, const filter_matcher& filter, bool found, bool no_update, bool should_filter) {
 		auto cur_pos = out_procs.size();
 		bool filtering = false;
 
 		//? If filtering, include children of matching processes
 		if (not found and (should_filter or not filter.empty())) {
-			if (not s_contains(std::to_string(cur_proc.pid), filter)
-			and not s_contains_ic(cur_proc.name, filter)
-			and not s_contains_ic(cur_proc.cmd, filter)
-			and not s_contains_ic(cur_proc.user, filter)) {
+			if (not filter(cur_proc)) {
 				filtering = true;
 				cur_proc.filtered = true;
 				filter_found++;
@@ -129,7 +454,7 @@ namespace Proc {
 
 			//? Try to find name of the binary file and append to program name if not the same
 			if (cur_proc.short_cmd.empty() and not cur_proc.cmd.empty()) {
-				std::string_view cmd_view = cur_proc.cmd;
+				std::string_view cmd_view = cur_proc.cmd.str();
 				cmd_view = cmd_view.substr((size_t)0, std::min(cmd_view.find(' '), cmd_view.size()));
 				cmd_view = cmd_view.substr(std::min(cmd_view.find_last_of('/') + 1, cmd_view.size()));
 				cur_proc.short_cmd = string{cmd_view};
@@ -153,6 +478,8 @@ namespace Proc {
 				cur_proc.cpu_c += p.cpu_c;
 				cur_proc.mem += p.mem;
 				cur_proc.threads += p.threads;
+				cur_proc.net_rx += p.net_rx;
+				cur_proc.net_tx += p.net_tx;
 				filter_found++;
 				p.filtered = true;
 			}
@@ -18,17 +18,23 @@ tab-size = 4
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <deque>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <ifaddrs.h>
 #include <robin_hood.h>
 #include <unistd.h>
 
+#include "btop_tools.hpp"
+
 using robin_hood::unordered_flat_map;
 using std::array;
 using std::atomic;
@@ -36,9 +42,45 @@ using std::deque;
 using std::string;
 using std::tuple;
 using std::vector;
+using Tools::RingBuffer;
 
 using namespace std::literals; // for operator""s
 
+//* Array with one <T> for each value of <Enum>, <names> holds the name of each value as used in config and theme options
+//* Lookup by name compares against <names> in order and is only meant for options and code paths still keyed by strings
+template<typename Enum, typename T, const auto& names>
+class enum_array {
+	array<T, names.size()> values{};
+public:
+	static constexpr size_t size() { return names.size(); }
+	static constexpr std::string_view name(Enum key) { return names[static_cast<size_t>(key)]; }
+
+	//* Index of <name>, throws std::out_of_range if not found
+	static size_t index(std::string_view name) {
+		for (size_t i = 0; i < names.size(); i++)
+			if (names[i] == name) return i;
+		throw std::out_of_range("enum_array: unknown name " + string(name));
+	}
+	static Enum key(std::string_view name) { return static_cast<Enum>(index(name)); }
+	static bool contains(std::string_view name) {
+		return std::find(names.begin(), names.end(), name) != names.end();
+	}
+
+	T& operator[](Enum key) { return values[static_cast<size_t>(key)]; }
+	const T& operator[](Enum key) const { return values[static_cast<size_t>(key)]; }
+	T& at(Enum key) { return values[static_cast<size_t>(key)]; }
+	const T& at(Enum key) const { return values[static_cast<size_t>(key)]; }
+	T& operator[](std::string_view name) { return values[index(name)]; }
+	const T& operator[](std::string_view name) const { return values[index(name)]; }
+	T& at(std::string_view name) { return values[index(name)]; }
+	const T& at(std::string_view name) const { return values[index(name)]; }
+
+	auto begin() { return values.begin(); }
+	auto end() { return values.end(); }
+	auto begin() const { return values.begin(); }
+	auto end() const { return values.end(); }
+};
+
 void term_resize(bool force=false);
 void banner_gen();
 
@@ -89,29 +131,30 @@ namespace Shared {
 namespace Cpu {
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
-	extern bool shown, redraw, got_sensors, cpu_temp_only, has_battery;
+	extern bool shown, redraw, got_sensors, cpu_temp_only, has_battery, has_core_freq;
 	extern string cpuName, cpuHz;
 	extern vector<string> available_fields;
 	extern vector<string> available_sensors;
 	extern tuple<int, long, string> current_bat;
 
+	//* Cpu usage fields, "total" followed by the cpu times in the order of /proc/stat
+	enum class field : uint8_t { total, user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice };
+	inline constexpr array<std::string_view, 11> field_names = {
+		"total", "user", "nice", "system", "idle", "iowait", "irq", "softirq", "steal", "guest", "guest_nice"
+	};
+
+	//* Context switches and interrupts per second, running and blocked task counts
+	enum class sched_field : uint8_t { ctxt, intr, running, blocked };
+	inline constexpr array<std::string_view, 4> sched_names = { "ctxt", "intr", "running", "blocked" };
+
 	struct cpu_info {
-		unordered_flat_map<string, deque<long long>> cpu_percent = {
-			{"total", {}},
-			{"user", {}},
-			{"nice", {}},
-			{"system", {}},
-			{"idle", {}},
-			{"iowait", {}},
-			{"irq", {}},
-			{"softirq", {}},
-			{"steal", {}},
-			{"guest", {}},
-			{"guest_nice", {}}
-		};
-		vector<deque<long long>> core_percent;
-		vector<deque<long long>> temp;
+		enum_array<field, RingBuffer<uint8_t>, field_names> cpu_percent;
+		enum_array<sched_field, RingBuffer<long long>, sched_names> sched_stats;  // (Linux only)
+		vector<RingBuffer<uint8_t>> core_percent;
+		vector<RingBuffer<long long>> temp;
 		long long temp_max = 0;
+		vector<RingBuffer<long long>> core_freq;  // MHz (Linux only)
+		long long freq_max = 0;                   // MHz, highest cpuinfo_max_freq of all cores (Linux only)
 		array<double, 3> load_avg;
 	};
 
@@ -133,8 +176,14 @@ namespace Mem {
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
 	extern bool has_swap, shown, redraw;
-	const array mem_names { "used"s, "available"s, "cached"s, "free"s };
-	const array swap_names { "swap_used"s, "swap_free"s };
+
+	//* Memory and swap fields
+	enum class field : uint8_t { used, available, cached, free, swap_total, swap_used, swap_free };
+	inline constexpr array<std::string_view, 7> field_names = {
+		"used", "available", "cached", "free", "swap_total", "swap_used", "swap_free"
+	};
+	inline constexpr array mem_names { field::used, field::available, field::cached, field::free };
+	inline constexpr array swap_names { field::swap_used, field::swap_free };
 	extern int disk_ios;
 
 	struct disk_info {
@@ -142,25 +191,31 @@ namespace Mem {
 		string name;
 		string fstype{};                // defaults to ""
 		std::filesystem::path stat{};   // defaults to ""
+		uint64_t devno{};               // (Linux) major:minor of block device in /proc/diskstats, defaults to 0
 		int64_t total{};                // defaults to 0
 		int64_t used{};                 // defaults to 0
 		int64_t free{};                 // defaults to 0
 		int used_percent{};             // defaults to 0
 		int free_percent{};             // defaults to 0
+		bool stale{};                   // usage not updated since statvfs() timed out, defaults to false
 
 		array<int64_t, 3> old_io = {0, 0, 0};
-		deque<long long> io_read = {};
-		deque<long long> io_write = {};
-		deque<long long> io_activity = {};
+		RingBuffer<long long> io_read = {};
+		RingBuffer<long long> io_write = {};
+		RingBuffer<uint8_t> io_activity = {};
+
+		//? Completed reads, completed writes, milliseconds spent on them and weighted milliseconds in queue since last update
+		array<int64_t, 4> old_ops = {0, 0, 0, 0};
+		bool has_ops{};                 // defaults to false
+		double ops_read{};              // read operations per second, defaults to 0.0
+		double ops_write{};             // write operations per second, defaults to 0.0
+		double await{};                 // average milliseconds per completed operation, defaults to 0.0
+		double queue{};                 // average operations in flight, defaults to 0.0
 	};
 
 	struct mem_info {
-		unordered_flat_map<string, uint64_t> stats =
-			{{"used", 0}, {"available", 0}, {"cached", 0}, {"free", 0},
-			{"swap_total", 0}, {"swap_used", 0}, {"swap_free", 0}};
-		unordered_flat_map<string, deque<long long>> percent =
-			{{"used", {}}, {"available", {}}, {"cached", {}}, {"free", {}},
-			{"swap_total", {}}, {"swap_used", {}}, {"swap_free", {}}};
+		enum_array<field, uint64_t, field_names> stats;
+		enum_array<field, RingBuffer<uint8_t>, field_names> percent;
 		unordered_flat_map<string, disk_info> disks;
 		vector<string> disks_order;
 	};
@@ -183,7 +238,14 @@ namespace Net {
 	extern string selected_iface;
 	extern vector<string> interfaces;
 	extern bool rescale;
-	extern unordered_flat_map<string, uint64_t> graph_max;
+
+	//* "download" is received and "upload" is transmitted
+	enum class direction : uint8_t { download, upload };
+	inline constexpr array<std::string_view, 2> direction_names = { "download", "upload" };
+	inline constexpr array directions { direction::download, direction::upload };
+	template<typename T> using per_direction = enum_array<direction, T, direction_names>;
+
+	extern per_direction<uint64_t> graph_max, packet_max;
 
 	struct net_stat {
 		uint64_t speed{};       // defaults to 0
@@ -195,8 +257,15 @@ namespace Net {
 	};
 
 	struct net_info {
-		unordered_flat_map<string, deque<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
-		unordered_flat_map<string, net_stat> stat = { {"download", {}}, {"upload", {}} };
+		per_direction<RingBuffer<long long>> bandwidth;
+		per_direction<net_stat> stat;
+		//? Packets, errors and drops per second
+		per_direction<RingBuffer<long long>> packets;
+		per_direction<RingBuffer<long long>> errors;
+		per_direction<RingBuffer<long long>> drops;
+		per_direction<net_stat> packet_stat;
+		per_direction<net_stat> error_stat;
+		per_direction<net_stat> drop_stat;
 		string ipv4{};      // defaults to ""
 		string ipv6{};      // defaults to ""
 		bool connected{};   // defaults to false
@@ -204,6 +273,30 @@ namespace Net {
 
 	extern unordered_flat_map<string, net_info> current_net;
 
+	struct connection_info {
+		string local{};         // defaults to ""
+		string remote{};        // defaults to ""
+		string name{};          // program owning the socket, empty if not found
+		size_t pid{};           // defaults to 0
+		uint64_t rx_rate{};     // bytes received per second
+		uint64_t tx_rate{};     // bytes acknowledged by the peer per second
+		uint32_t rtt{};         // smoothed round trip time in microseconds
+		uint32_t retrans{};     // total retransmitted segments
+	};
+
+	//? TCP connections with the highest throughput and number of TCP sockets found, only collected if net_connections is set
+	extern vector<connection_info> connections;
+	extern size_t connection_count;
+
+	//* Protocol counters, orphans and time_wait are socket counts and the rest are rates per second
+	enum class protocol : uint8_t { retrans, resets, listen_overflows, orphans, time_wait, udp_rcvbuf_errors };
+	inline constexpr array<std::string_view, 6> protocol_names = {
+		"retrans", "resets", "listen_overflows", "orphans", "time_wait", "udp_rcvbuf_errors"
+	};
+
+	//? History of protocol counters for the protocols view, only collected if net_protocols is set
+	extern enum_array<protocol, RingBuffer<long long>, protocol_names> protocols;
+
 	//* Collect net upload/download stats
 	auto collect(bool no_update=false) -> net_info&;
 
@@ -214,6 +307,9 @@ namespace Net {
 namespace Proc {
 	extern atomic<int> numpids;
 
+	//? Number of processes read in last update
+	extern atomic<int> pids_read;
+
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
 	extern bool shown, redraw;
@@ -232,6 +328,7 @@ namespace Proc {
 		"memory",
 		"cpu direct",
 		"cpu lazy",
+		"network",
 	};
 
 	//? Translation from process state char to explanative string
@@ -249,28 +346,109 @@ namespace Proc {
 		{'P', "Parked"}
 	};
 
+	//* Reference counted handle to a string interned in a pool shared by all processes, equal strings are only
+	//* stored once and compare equal by handle, a pooled string is freed when its last handle is released
+	class pooled_string {
+		struct entry {
+			const string str;
+			size_t refs;
+			string lower{};     // lowercase copy, created by first call to lower(), defaults to ""
+		};
+		entry* ptr{};
+
+		void acquire(entry* other);
+		void release();
+	public:
+		pooled_string() = default;
+		pooled_string(std::string_view str) { assign(str); }
+		pooled_string(const pooled_string& other) { acquire(other.ptr); }
+		pooled_string(pooled_string&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+		~pooled_string() { release(); }
+
+		pooled_string& operator=(const pooled_string& other) {
+			if (ptr != other.ptr) { release(); acquire(other.ptr); }
+			return *this;
+		}
+		pooled_string& operator=(pooled_string&& other) noexcept {
+			if (this != &other) { release(); ptr = std::exchange(other.ptr, nullptr); }
+			return *this;
+		}
+		pooled_string& operator=(std::string_view str) { assign(str); return *this; }
+
+		//* Replace handle with handle for <str>, adding <str> to the pool if not already present
+		void assign(std::string_view str);
+
+		const string& str() const;
+		operator const string&() const { return str(); }
+
+		//* Lowercase copy of the string, created on first use and shared by all handles, only called from the runner thread
+		const string& lower() const;
+		bool empty() const { return ptr == nullptr; }
+		size_t size() const { return str().size(); }
+		bool operator==(const pooled_string& other) const { return ptr == other.ptr; }
+
+		//* Approximate heap bytes used by the pool and heap bytes all current handles would use as separate strings
+		static size_t pool_bytes();
+		static size_t referenced_bytes();
+	};
+
 	//* Container for process information
 	struct proc_info {
 		size_t pid{};           // defaults to 0
-		string name{};          // defaults to ""
-		string cmd{};           // defaults to ""
+		pooled_string name{};   // defaults to ""
+		pooled_string cmd{};    // defaults to ""
 		string short_cmd{};     // defaults to ""
 		size_t threads{};       // defaults to 0
-		int name_offset{};      // defaults to 0
-		string user{};          // defaults to ""
+		pooled_string user{};   // defaults to ""
 		uint64_t mem{};         // defaults to 0
 		double cpu_p{};         // defaults to = 0.0
 		double cpu_c{};         // defaults to = 0.0
-		char state = '0';
 		int64_t p_nice{};      // defaults to 0
 		uint64_t ppid{};        // defaults to 0
 		uint64_t cpu_s{};       // defaults to 0
 		uint64_t cpu_t{};       // defaults to 0
+		uint64_t net_rx{};      // bytes received per second over tcp, defaults to 0
+		uint64_t net_tx{};      // bytes sent per second over tcp, defaults to 0
 		string prefix{};        // defaults to ""
 		size_t depth{};         // defaults to 0
 		size_t tree_index{};    // defaults to 0
 		bool collapsed{};       // defaults to false
 		bool filtered{};        // defaults to false
+		char state = '0';       // kept with the flags to not pad the struct
+	};
+
+	//* Process filter compiled from filter text, a process matches if all space separated terms match
+	//* Plain terms are matched case insensitive against pid, name, command and user, use quotes to include spaces
+	//* "pid:", "name:", "cmd:" and "user:" limits a term to one field, "cpu", "mem" and "threads" can be compared with
+	//* >, <, >=, <= and = against a number (mem accepts K, M, G and T suffixes), a leading "!" negates a term
+	class filter_matcher {
+		enum class field : uint8_t { any, pid, name, cmd, user, cpu, mem, threads };
+		enum class compare : uint8_t { contains, greater, less, greater_eq, less_eq, equal };
+
+		struct term {
+			field target = field::any;
+			compare op = compare::contains;
+			bool negate{};      // defaults to false
+			string needle{};    // lowercase, defaults to ""
+			double value{};     // defaults to 0.0
+		};
+
+		vector<term> terms;
+
+		static bool term_match(const term& t, const proc_info& p);
+	public:
+		filter_matcher() = default;
+		explicit filter_matcher(const string& filter);
+
+		bool empty() const { return terms.empty(); }
+
+		//* Returns true if <p> matches all terms, lowercase copies of fields are cached in the string pool
+		bool operator()(const proc_info& p) const {
+			for (const auto& t : terms) {
+				if (term_match(t, p) == t.negate) return false;
+			}
+			return true;
+		}
 	};
 
 	//* Container for process info box
@@ -280,13 +458,16 @@ namespace Proc {
 		proc_info entry;
 		string elapsed, parent, status, io_read, io_write, memory;
 		long long first_mem = -1;
-		deque<long long> cpu_percent;
-		deque<long long> mem_bytes;
+		RingBuffer<uint8_t> cpu_percent;
+		RingBuffer<long long> mem_bytes;
 	};
 
 	//? Contains all info for proc detailed box
 	extern detail_container detailed;
 
+	//* Approximate heap bytes used for process data in <procs>, including the shared string pool
+	size_t memory_usage(const vector<proc_info>& procs);
+
 	//* Collect and sort process information from /proc
 	auto collect(bool no_update = false) -> vector<proc_info>&;
 
@@ -301,8 +482,9 @@ namespace Proc {
 		vector<tree_proc> children;
 	};
 
-	//* Sort vector of proc_info's
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false);
+	//* Sort vector of proc_info's, if <rows> is above 0 only the first <rows> processes not filtered are sorted
+	//* Returns number of processes from the start of <proc_vec> that are in sorted order
+	size_t proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false, size_t rows = 0);
 
 	//* Recursive sort of process tree
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting,
@@ -310,6 +492,6 @@ namespace Proc {
 
 	//* Generate process tree list
 	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
-				   int cur_depth, bool collapsed, const string& filter,
+				   int cur_depth, bool collapsed, const filter_matcher& filter,
 				   bool found = false, bool no_update = false, bool should_filter = false);
 }
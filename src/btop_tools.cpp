@@ -26,6 +26,7 @@ tab-size = 4
 #include <utility>
 #include <ranges>
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <termios.h>
 #include <sys/ioctl.h>
@@ -498,17 +499,71 @@ namespace Tools {
 	}
 
 	string readfile(const std::filesystem::path& path, const string& fallback) {
-		if (not fs::exists(path)) return fallback;
+		static const FileReader reader;
 		string out;
-		try {
-			std::ifstream file(path);
-			for (string readstr; getline(file, readstr); out += readstr);
+		if (not reader.read(path.c_str(), out)) return fallback;
+		std::erase(out, '\n');
+		return (out.empty() ? fallback : out);
+	}
+
+	FileReader::FileReader(const fs::path& dir) {
+		open_dir(dir);
+	}
+
+	FileReader::~FileReader() {
+		if (dir_fd >= 0) close(dir_fd);
+	}
+
+	bool FileReader::open_dir(const fs::path& dir) {
+		if (dir_fd >= 0) close(dir_fd);
+		dir_fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (dir_fd < 0) {
+			dir_fd = AT_FDCWD;
+			return false;
 		}
-		catch (const std::exception& e) {
-			Logger::error("readfile() : Exception when reading " + string{path} + " : " + e.what());
-			return fallback;
+		return true;
+	}
+
+	namespace {
+		thread_local string read_buffer;
+
+		//* Read <path> into read_buffer, keeping its size as capacity, and return number of bytes read or -1 if the file couldn't be opened
+		ssize_t read_fd(const int dir_fd, const char* path, const size_t limit) {
+			const int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0) return -1;
+			auto& buffer = read_buffer;
+			if (buffer.size() < 4096) buffer.resize(4096);
+			size_t len = 0;
+			for (;;) {
+				if (len + 1 >= buffer.size()) buffer.resize(buffer.size() * 2);
+				size_t want = buffer.size() - len - 1;
+				if (limit > 0) want = std::min(want, limit - len);
+				if (want == 0) break;
+				const ssize_t got = ::read(fd, buffer.data() + len, want);
+				if (got < 0 and errno == EINTR) continue;
+				if (got <= 0) break;
+				len += got;
+			}
+			close(fd);
+			buffer[len] = '\0';
+			return len;
 		}
-		return (out.empty() ? fallback : out);
+	}
+
+	bool FileReader::read(const char* path, string& buffer, size_t limit) const {
+		const ssize_t len = read_fd(dir_fd, path, limit);
+		if (len < 0) {
+			buffer.clear();
+			return false;
+		}
+		buffer.assign(read_buffer.data(), len);
+		return true;
+	}
+
+	std::string_view FileReader::read(const char* path, size_t limit) const {
+		const ssize_t len = read_fd(dir_fd, path, limit);
+		if (len <= 0) return {};
+		return {read_buffer.data(), static_cast<size_t>(len)};
 	}
 
 	auto celsius_to(const long long& celsius, const string& scale) -> tuple<long long, string> {
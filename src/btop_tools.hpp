@@ -21,11 +21,18 @@ tab-size = 4
 #include <algorithm>        // for std::ranges::count_if
 #include <array>
 #include <atomic>
+#include <charconv>
 #include <chrono>
+#include <compare>
+#include <concepts>
 #include <filesystem>
+#include <initializer_list>
+#include <iterator>
 #include <ranges>
 #include <regex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -332,9 +339,170 @@ namespace Tools {
 	//* Read a complete file and return as a string
 	string readfile(const std::filesystem::path& path, const string& fallback = "");
 
+	//* Reads files with plain open()/read() calls instead of a std::ifstream
+	//* Relative paths are opened with openat() on a cached directory fd if a directory is set, absolute paths are opened as is
+	class FileReader {
+		int dir_fd = -100; // AT_FDCWD
+	public:
+		FileReader() = default;
+		explicit FileReader(const std::filesystem::path& dir);
+		~FileReader();
+		FileReader(const FileReader&) = delete;
+		FileReader& operator=(const FileReader&) = delete;
+
+		//* Set directory used as base for relative paths, returns false if it couldn't be opened
+		bool open_dir(const std::filesystem::path& dir);
+
+		//* Read up to <limit> bytes (0 = no limit) of <path> into <buffer>, returns false if the file couldn't be opened
+		bool read(const char* path, string& buffer, size_t limit = 0) const;
+
+		//* Read up to <limit> bytes (0 = no limit) of <path> into a per-thread buffer and return a view of the contents
+		//* The view is null terminated and valid until the next call to read() on the same thread, empty on failure
+		std::string_view read(const char* path, size_t limit = 0) const;
+	};
+
+	//* Return next token in <sv> separated by <delim> skipping any leading delimiters, <sv> is advanced past the token
+	inline std::string_view next_token(std::string_view& sv, const char delim = ' ') {
+		const auto start = sv.find_first_not_of(delim);
+		if (start == std::string_view::npos) {
+			sv = {};
+			return {};
+		}
+		const auto end = sv.find(delim, start);
+		const auto token = sv.substr(start, end - start);
+		sv.remove_prefix(end == std::string_view::npos ? sv.size() : end + 1);
+		return token;
+	}
+
+	//* Return next token in <sv> separated by any of the characters in <delims>, <sv> is advanced past the token
+	inline std::string_view next_token(std::string_view& sv, std::string_view delims) {
+		const auto start = sv.find_first_not_of(delims);
+		if (start == std::string_view::npos) {
+			sv = {};
+			return {};
+		}
+		const auto end = sv.find_first_of(delims, start);
+		const auto token = sv.substr(start, end - start);
+		sv.remove_prefix(end == std::string_view::npos ? sv.size() : end + 1);
+		return token;
+	}
+
+	//* Convert leading digits of <sv> to an integer, returns <fallback> if <sv> doesn't start with a number
+	template<std::integral T>
+	inline T sv_to(std::string_view sv, T fallback = 0) {
+		T value;
+		const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+		return (ec == std::errc() ? value : fallback);
+	}
+
 	//* Convert a celsius value to celsius, fahrenheit, kelvin or rankin and return tuple with new value and unit.
 	auto celsius_to(const long long& celsius, const string& scale) -> tuple<long long, string>;
 
+	//* Contiguous circular buffer used for graph history, push_back() and pop_front() never move or allocate single elements
+	//* Storage is a power of two that only grows when full, so it settles at the largest size kept by the collectors
+	template<typename T>
+	class RingBuffer {
+		vector<T> buffer;
+		size_t head{}, count{};
+
+		void grow() {
+			vector<T> larger(std::max((size_t)16, buffer.size() * 2));
+			for (size_t i = 0; i < count; i++) larger[i] = (*this)[i];
+			buffer.swap(larger);
+			head = 0;
+		}
+
+	public:
+		using value_type = T;
+		using size_type = size_t;
+
+		//* Random access iterator over the values from oldest to newest
+		template<bool Const>
+		class basic_iterator {
+			using ring_type = std::conditional_t<Const, const RingBuffer, RingBuffer>;
+			ring_type* ring{};
+			size_t pos{};
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::conditional_t<Const, const T&, T&>;
+			using pointer = std::conditional_t<Const, const T*, T*>;
+
+			basic_iterator() = default;
+			basic_iterator(ring_type* ring, size_t pos) : ring(ring), pos(pos) {}
+			operator basic_iterator<true>() const requires (not Const) { return {ring, pos}; }
+
+			reference operator*() const { return (*ring)[pos]; }
+			pointer operator->() const { return &(*ring)[pos]; }
+			reference operator[](difference_type n) const { return (*ring)[pos + n]; }
+			basic_iterator& operator++() { ++pos; return *this; }
+			basic_iterator operator++(int) { auto old = *this; ++pos; return old; }
+			basic_iterator& operator--() { --pos; return *this; }
+			basic_iterator operator--(int) { auto old = *this; --pos; return old; }
+			basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+			basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+			friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+			friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+			friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+			friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) { return (difference_type)a.pos - (difference_type)b.pos; }
+			friend bool operator==(const basic_iterator& a, const basic_iterator& b) { return a.pos == b.pos; }
+			friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) { return a.pos <=> b.pos; }
+		};
+		using iterator = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		RingBuffer() = default;
+		RingBuffer(size_t size, const T& value) {
+			for (size_t i = 0; i < size; i++) push_back(value);
+		}
+		RingBuffer(std::initializer_list<T> values) {
+			for (const auto& value : values) push_back(value);
+		}
+
+		size_t size() const { return count; }
+		size_t capacity() const { return buffer.size(); }
+		bool empty() const { return count == 0; }
+
+		T& operator[](size_t i) { return buffer[(head + i) & (buffer.size() - 1)]; }
+		const T& operator[](size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
+		T& at(size_t i) {
+			if (i >= count) throw std::out_of_range("RingBuffer::at");
+			return (*this)[i];
+		}
+		const T& at(size_t i) const {
+			if (i >= count) throw std::out_of_range("RingBuffer::at");
+			return (*this)[i];
+		}
+		T& front() { return (*this)[0]; }
+		const T& front() const { return (*this)[0]; }
+		T& back() { return (*this)[count - 1]; }
+		const T& back() const { return (*this)[count - 1]; }
+
+		iterator begin() { return {this, 0}; }
+		iterator end() { return {this, count}; }
+		const_iterator begin() const { return {this, 0}; }
+		const_iterator end() const { return {this, count}; }
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+		void push_back(const T& value) {
+			if (count == buffer.size()) grow();
+			(*this)[count++] = value;
+		}
+		void pop_front() {
+			head = (head + 1) & (buffer.size() - 1);
+			count--;
+		}
+		void pop_back() { count--; }
+		void clear() { head = count = 0; }
+	};
+
 }
 
 //* Simple logging implementation
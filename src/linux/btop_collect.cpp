@@ -21,13 +21,33 @@ tab-size = 4
 #include <fstream>
 #include <ranges>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unistd.h>
 #include <numeric>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <sys/statvfs.h>
+#include <sys/sysmacros.h>
+#include <sys/utsname.h>
 #include <netdb.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <arpa/inet.h> // for inet_ntop()
+#include <poll.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/tcp.h>
+#include <dirent.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
 #include <filesystem>
 
 #if !(defined(STATIC_BUILD) && defined(__GLIBC__))
@@ -41,7 +61,6 @@ tab-size = 4
 using std::clamp;
 using std::cmp_greater;
 using std::cmp_less;
-using std::ifstream;
 using std::max;
 using std::min;
 using std::numeric_limits;
@@ -63,6 +82,9 @@ namespace Cpu {
 	vector<string> available_sensors = {"Auto"};
 	cpu_info current_cpu;
 	fs::path freq_path = "/sys/devices/system/cpu/cpufreq/policy0/scaling_cur_freq";
+	fs::path core_freq_base = "/sys/devices/system/cpu";
+	vector<int> core_freq_fds;
+	bool core_freq_retry{}; // open inputs missing for some cores again, set when the online cores change, defaults to false
 	bool got_sensors{};     // defaults to false
 	bool cpu_temp_only{};   // defaults to false
 
@@ -72,6 +94,12 @@ namespace Cpu {
 	//* Get current cpu clock speed
 	string get_cpuHz();
 
+	//* Open scaling_cur_freq of new cores and of cores without an input if <retry>, returns true if any core has an open input
+	bool open_core_freq(cpu_info& cpu, bool retry = false);
+
+	//* Read current frequency of each core into cpu.core_freq, at most once every core_freq_ms
+	void update_core_freq(cpu_info& cpu);
+
 	//* Search /proc/cpuinfo for a cpu name
 	string get_cpuName();
 
@@ -81,8 +109,15 @@ namespace Cpu {
 		int64_t temp{}; // defaults to 0
 		int64_t high{}; // defaults to 0
 		int64_t crit{}; // defaults to 0
+		int fd{-1};     // input file kept open between reads, defaults to -1
 	};
 
+	//* Read current temperature of <sensor> into sensor.temp, returns false if the input file couldn't be read
+	bool read_sensor(Sensor& sensor);
+
+	//* Signature of the sensor devices and kernel release used to validate the sensor cache
+	string sensor_signature();
+
 	unordered_flat_map<string, Sensor> found_sensors;
 	string cpu_sensor;
 	vector<string> core_sensors;
@@ -93,17 +128,91 @@ namespace Mem {
 	double old_uptime;
 }
 
+namespace Proc {
+	extern vector<proc_info> current_procs;
+
+	//* Return the entry of <pid> in current_procs from the pid index, nullptr if not found
+	const proc_info* find_proc(const size_t pid);
+}
+
 namespace Shared {
 
 	fs::path procPath, passwd_path;
+	FileReader proc_dir;
 	long pageSize, clkTck, coreCount;
 
+	//* Times from one cpu line of /proc/stat, <num> is -1 for the line with totals for all cores
+	struct cpu_times {
+		int num{-1};
+		size_t fields{};
+		array<long long, 10> times{};
+
+		//* Sum of fields [first, last) that are present
+		long long sum(size_t first = 0, size_t last = 10) const {
+			long long total = 0;
+			for (size_t i = first; i < min(last, fields); i++) total += times[i];
+			return total;
+		}
+	};
+
+	//* /proc/stat parsed in a single pass, shared by the Cpu and Proc collectors so the file is read once per update
+	class ProcStat {
+		unsigned consumed{};
+	public:
+		enum consumer : unsigned { cpu = 1, proc = 2 };
+		uint64_t timestamp{};
+		cpu_times total;
+		vector<cpu_times> cores;
+		size_t core_count{};
+		uint64_t ctxt{}, intr{}, procs_running{}, procs_blocked{};
+
+		//* Read /proc/stat unless the current snapshot is from this update and not yet used by <who>, returns false on failure
+		bool get(consumer who) {
+			if (timestamp > 0 and not (consumed & who) and time_ms() - timestamp < (uint64_t)Config::getI("update_ms")) {
+				consumed |= who;
+				return true;
+			}
+			const auto stat = proc_dir.read("stat");
+			if (stat.empty()) return false;
+
+			std::string_view rest = stat;
+			core_count = 0;
+			total.fields = 0;
+			while (not rest.empty()) {
+				auto line = next_token(rest, '\n');
+				const auto name = next_token(line);
+				if (name.starts_with("cpu")) {
+					auto* entry = &total;
+					if (name.size() > 3) {
+						//? Entries are kept between reads so the core array is only grown when more cores show up
+						if (core_count == cores.size()) cores.emplace_back();
+						entry = &cores[core_count++];
+						entry->num = sv_to<int>(name.substr(3), -1);
+					}
+					entry->fields = 0;
+					for (auto val = next_token(line); not val.empty() and entry->fields < entry->times.size(); val = next_token(line))
+						entry->times[entry->fields++] = sv_to<long long>(val);
+				}
+				else if (name == "intr") intr = sv_to<uint64_t>(next_token(line));
+				else if (name == "ctxt") ctxt = sv_to<uint64_t>(next_token(line));
+				else if (name == "procs_running") procs_running = sv_to<uint64_t>(next_token(line));
+				else if (name == "procs_blocked") procs_blocked = sv_to<uint64_t>(next_token(line));
+			}
+			timestamp = time_ms();
+			consumed = who;
+			return true;
+		}
+	};
+	ProcStat proc_stat;
+
 	void init() {
 
 		//? Shared global variables init
 		procPath = (fs::is_directory(fs::path("/proc")) and access("/proc", R_OK) != -1) ? "/proc" : "";
 		if (procPath.empty())
 			throw std::runtime_error("Proc filesystem not found or no permission to read from it!");
+		if (not proc_dir.open_dir(procPath))
+			throw std::runtime_error("Failed to open /proc directory!");
 
 		passwd_path = (fs::is_regular_file(fs::path("/etc/passwd")) and access("/etc/passwd", R_OK) != -1) ? "/etc/passwd" : "";
 		if (passwd_path.empty())
@@ -136,10 +245,11 @@ namespace Shared {
 		Cpu::current_cpu.temp.insert(Cpu::current_cpu.temp.begin(), Shared::coreCount + 1, {});
 		Cpu::core_old_totals.insert(Cpu::core_old_totals.begin(), Shared::coreCount, 0);
 		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
+		Cpu::has_core_freq = Cpu::open_core_freq(Cpu::current_cpu);
 		Cpu::collect();
 		if (Runner::coreNum_reset) Runner::coreNum_reset = false;
-		for (auto& [field, vec] : Cpu::current_cpu.cpu_percent) {
-			if (not vec.empty()) Cpu::available_fields.push_back(field);
+		for (const auto& name : Cpu::field_names) {
+			if (not Cpu::current_cpu.cpu_percent.at(name).empty()) Cpu::available_fields.push_back(string(name));
 		}
 		Cpu::cpuName = Cpu::get_cpuName();
 		Cpu::got_sensors = Cpu::get_sensors();
@@ -160,40 +270,33 @@ namespace Cpu {
 	string cpuName;
 	string cpuHz;
 	bool has_battery = true;
+	bool has_core_freq{}; // defaults to false
 	tuple<int, long, string> current_bat;
 
-	const array time_names {
-		"user"s, "nice"s, "system"s, "idle"s, "iowait"s,
-		"irq"s, "softirq"s, "steal"s, "guest"s, "guest_nice"s
-	};
-
-	unordered_flat_map<string, long long> cpu_old = {
-			{"totals", 0},
-			{"idles", 0},
-			{"user", 0},
-			{"nice", 0},
-			{"system", 0},
-			{"idle", 0},
-			{"iowait", 0},
-			{"irq", 0},
-			{"softirq", 0},
-			{"steal", 0},
-			{"guest", 0},
-			{"guest_nice", 0}
-	};
+	//? Values from the last read of the /proc/stat total line, <old_times> in the order of the fields after "total"
+	long long old_totals{}, old_idles{};
+	array<long long, 10> old_times{};
+
+	//* Value after the ':' of the first line in <cpuinfo> starting with <key>, <cpuinfo> is advanced past that line, empty if not found
+	std::string_view cpuinfo_value(std::string_view& cpuinfo, std::string_view key) {
+		while (not cpuinfo.empty()) {
+			auto line = next_token(cpuinfo, '\n');
+			if (not line.starts_with(key)) continue;
+			if (const auto colon = line.find(':'); colon != std::string_view::npos) {
+				line.remove_prefix(colon + 1);
+				if (line.starts_with(' ')) line.remove_prefix(1);
+				return line;
+			}
+		}
+		return {};
+	}
 
 	string get_cpuName() {
 		string name;
-		ifstream cpuinfo(Shared::procPath / "cpuinfo");
-		if (cpuinfo.good()) {
-			for (string instr; getline(cpuinfo, instr, ':') and not instr.starts_with("model name");)
-				cpuinfo.ignore(SSmax, '\n');
-			if (cpuinfo.bad()) return name;
-			else if (not cpuinfo.eof()) {
-				cpuinfo.ignore(1);
-				getline(cpuinfo, name);
-			}
-			else if (fs::exists("/sys/devices")) {
+		auto cpuinfo = Shared::proc_dir.read("cpuinfo");
+		if (not cpuinfo.empty()) {
+			name = cpuinfo_value(cpuinfo, "model name");
+			if (name.empty() and fs::exists("/sys/devices")) {
 				for (const auto& d : fs::directory_iterator("/sys/devices")) {
 					if (string(d.path().filename()).starts_with("arm")) {
 						name = d.path().filename();
@@ -249,10 +352,115 @@ namespace Cpu {
 		return name;
 	}
 
+	bool read_sensor(Sensor& sensor) {
+		if (sensor.fd < 0 and (sensor.fd = open(sensor.path.c_str(), O_RDONLY | O_CLOEXEC)) < 0) {
+			sensor.temp = 0;
+			return false;
+		}
+		char buf[32];
+		const ssize_t len = pread(sensor.fd, buf, sizeof(buf) - 1, 0);
+		if (len <= 0) {
+			//? Closed on errors so the file is opened again on the next read, in case the hwmon device was registered again
+			close(sensor.fd);
+			sensor.fd = -1;
+			sensor.temp = 0;
+			return false;
+		}
+		sensor.temp = sv_to<int64_t>(std::string_view(buf, len)) / 1000;
+		return true;
+	}
+
+	string sensor_signature() {
+		vector<string> entries;
+
+		//? Only the device directories are listed, devices themselves aren't searched and no sensor files are read
+		//? A device registered again gets a new inode in sysfs, mtime isn't used since sysfs sets it when the inode is first looked up
+		const auto list = [&entries](const char* path, std::string_view prefix) {
+			DIR* dir = opendir(path);
+			if (dir == nullptr) return;
+			char target[256];
+			while (const auto* entry = readdir(dir)) {
+				const std::string_view name = entry->d_name;
+				if (not name.starts_with(prefix)) continue;
+				const ssize_t len = (entry->d_type == DT_LNK ? readlinkat(dirfd(dir), entry->d_name, target, sizeof(target)) : 0);
+				entries.push_back(fmt::format("{}/{}>{}>{}", path, name, entry->d_ino, std::string_view(target, max<ssize_t>(len, 0))));
+			}
+			closedir(dir);
+		};
+		list("/sys/class/hwmon", "hwmon");
+		list("/sys/devices/platform/coretemp.0/hwmon", "hwmon");
+		list("/sys/class/thermal", "thermal_zone");
+		rng::sort(entries);
+
+		struct utsname uts;
+		string signature = Global::Version + '|' + (uname(&uts) == 0 ? uts.release : "");
+		for (const auto& entry : entries) signature += '|' + entry;
+		return fmt::format("{:016x}", std::hash<string>{}(signature));
+	}
+
 	bool get_sensors() {
 		bool got_cpu = false, got_coretemp = false;
 		vector<fs::path> search_paths;
-		try {
+
+		//? Sensor names in the order found, true for hwmon sensors, kept to write the sensor cache
+		vector<std::pair<bool, string>> found_order;
+		auto add_sensor = [&](bool hwmon, const string& sensor_name, Sensor&& sensor) {
+			if (auto old = found_sensors.find(sensor_name); old != found_sensors.end() and old->second.fd >= 0) close(old->second.fd);
+			const string label = sensor.label;
+			found_sensors[sensor_name] = std::move(sensor);
+			found_order.emplace_back(hwmon, sensor_name);
+			if (not hwmon) return;
+
+			if (not got_cpu and (label.starts_with("Package id") or label.starts_with("Tdie"))) {
+				got_cpu = true;
+				cpu_sensor = sensor_name;
+			}
+			else if (label.starts_with("Core") or label.starts_with("Tccd")) {
+				got_coretemp = true;
+				if (not v_contains(core_sensors, sensor_name)) core_sensors.push_back(sensor_name);
+			}
+		};
+
+		//? Sensors found on the last start are reused if the signature of the sensor hardware is unchanged
+		const fs::path cache_file = (Config::conf_dir.empty() ? fs::path{} : Config::conf_dir / "sensors.cache");
+		const string signature = (cache_file.empty() ? "" : sensor_signature());
+		bool from_cache = false;
+		if (not signature.empty()) {
+			try {
+				string cache;
+				std::string_view rest;
+				if (Shared::proc_dir.read(cache_file.c_str(), cache)) rest = cache;
+				if (next_token(rest, '\n') == "signature " + signature) {
+					from_cache = true;
+					while (from_cache and not rest.empty()) {
+						const auto fields = ssplit(string{next_token(rest, '\n')}, '\t');
+						if (fields.size() != 6) {
+							from_cache = false;
+							break;
+						}
+						Sensor sensor{fields.at(2), fields.at(3), 0, stol(fields.at(4)), stol(fields.at(5))};
+
+						//? A sensor that can't be read means the cache is outdated
+						from_cache = read_sensor(sensor);
+						add_sensor(fields.at(0) == "hwmon", fields.at(1), std::move(sensor));
+					}
+				}
+			}
+			catch (...) { from_cache = false; }
+
+			if (not from_cache) {
+				for (auto& [name, sensor] : found_sensors) {
+					if (sensor.fd >= 0) close(sensor.fd);
+				}
+				found_sensors.clear();
+				found_order.clear();
+				core_sensors.clear();
+				cpu_sensor.clear();
+				got_cpu = got_coretemp = false;
+			}
+		}
+
+		if (not from_cache) try {
 			//? Setup up paths to search for sensors
 			if (fs::exists(fs::path("/sys/class/hwmon")) and access("/sys/class/hwmon", R_OK) != -1) {
 				for (const auto& dir : fs::directory_iterator(fs::path("/sys/class/hwmon"))) {
@@ -315,16 +523,7 @@ namespace Cpu {
 						const int64_t high = stol(readfile(fs::path(basepath + "max"), "80000")) / 1000;
 						const int64_t crit = stol(readfile(fs::path(basepath + "crit"), "95000")) / 1000;
 
-						found_sensors[sensor_name] = {fs::path(basepath + "input"), label, temp, high, crit};
-
-						if (not got_cpu and (label.starts_with("Package id") or label.starts_with("Tdie"))) {
-							got_cpu = true;
-							cpu_sensor = sensor_name;
-						}
-						else if (label.starts_with("Core") or label.starts_with("Tccd")) {
-							got_coretemp = true;
-							if (not v_contains(core_sensors, sensor_name)) core_sensors.push_back(sensor_name);
-						}
+						add_sensor(true, sensor_name, {fs::path(basepath + "input"), label, temp, high, crit});
 					}
 				}
 			}
@@ -348,13 +547,26 @@ namespace Cpu {
 					if (high < 1) high = 80;
 					if (crit < 1) crit = 95;
 
-					found_sensors[sensor_name] = {basepath / "temp", label, temp, high, crit};
+					add_sensor(false, sensor_name, {basepath / "temp", label, temp, high, crit});
 				}
 			}
 
 		}
 		catch (...) {}
 
+		//? Save found sensors, also when none were found, so the next start can skip the scan
+		if (not from_cache and not signature.empty()) {
+			std::ofstream cache(cache_file, std::ios::trunc);
+			if (cache.good()) {
+				cache << "signature " << signature << '\n';
+				for (const auto& [hwmon, name] : found_order) {
+					const auto& sensor = found_sensors.at(name);
+					cache << (hwmon ? "hwmon" : "thermal") << '\t' << name << '\t' << sensor.path.string() << '\t' << sensor.label
+						<< '\t' << sensor.high << '\t' << sensor.crit << '\n';
+				}
+			}
+		}
+
 		if (not got_coretemp or core_sensors.empty()) {
 			cpu_temp_only = true;
 		}
@@ -386,7 +598,7 @@ namespace Cpu {
 
 		const auto& cpu_sensor = (not Config::getS("cpu_sensor").empty() and found_sensors.contains(Config::getS("cpu_sensor")) ? Config::getS("cpu_sensor") : Cpu::cpu_sensor);
 
-		found_sensors.at(cpu_sensor).temp = stol(readfile(found_sensors.at(cpu_sensor).path, "0")) / 1000;
+		read_sensor(found_sensors.at(cpu_sensor));
 		current_cpu.temp.at(0).push_back(found_sensors.at(cpu_sensor).temp);
 		current_cpu.temp_max = found_sensors.at(cpu_sensor).crit;
 		if (current_cpu.temp.at(0).size() > 20) current_cpu.temp.at(0).pop_front();
@@ -395,7 +607,7 @@ namespace Cpu {
 			vector<string> done;
 			for (const auto& sensor : core_sensors) {
 				if (v_contains(done, sensor)) continue;
-				found_sensors.at(sensor).temp = stol(readfile(found_sensors.at(sensor).path, "0")) / 1000;
+				read_sensor(found_sensors.at(sensor));
 				done.push_back(sensor);
 			}
 			for (const auto& [core, temp] : core_mapping) {
@@ -407,6 +619,57 @@ namespace Cpu {
 		}
 	}
 
+	bool open_core_freq(cpu_info& cpu, bool retry) {
+		const auto open_input = [&](size_t core) {
+			const auto cpufreq = core_freq_base / ("cpu" + to_string(core)) / "cpufreq";
+			const int fd = open((cpufreq / "scaling_cur_freq").c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd >= 0) {
+				try {
+					cpu.freq_max = max(cpu.freq_max, stoll(readfile(cpufreq / "cpuinfo_max_freq", "0")) / 1000);
+				}
+				catch (const std::exception&) {}
+			}
+			return fd;
+		};
+		if (retry) {
+			for (size_t core = 0; core < core_freq_fds.size(); core++) {
+				if (core_freq_fds[core] < 0) core_freq_fds[core] = open_input(core);
+			}
+		}
+		while (cmp_less(core_freq_fds.size(), Shared::coreCount)) {
+			core_freq_fds.push_back(open_input(core_freq_fds.size()));
+			cpu.core_freq.emplace_back();
+		}
+		return rng::any_of(core_freq_fds, [](int fd) { return fd >= 0; });
+	}
+
+	void update_core_freq(cpu_info& cpu) {
+		static uint64_t last_read{}; // defaults to 0
+		const uint64_t now = time_ms();
+		if (last_read > 0 and now - last_read < (uint64_t)Config::getI("core_freq_ms")) return;
+		last_read = now;
+
+		char buf[32];
+		for (size_t core = 0; core < core_freq_fds.size(); core++) {
+			long long mhz = 0;
+			//? Inputs that fail to read, like for a core taken offline, are closed and opened again when the online cores change
+			if (int& fd = core_freq_fds[core]; fd >= 0) {
+				const ssize_t len = pread(fd, buf, sizeof(buf) - 1, 0);
+				if (len > 0) mhz = sv_to<long long>(std::string_view(buf, len)) / 1000;
+				else {
+					close(fd);
+					fd = -1;
+				}
+			}
+			auto& history = cpu.core_freq[core];
+			history.push_back(mhz);
+			if (history.size() > 40) history.pop_front();
+
+			//? Scale to highest frequency seen if cpuinfo_max_freq is missing or lower than boost frequencies
+			cpu.freq_max = max(cpu.freq_max, mhz);
+		}
+	}
+
 	string get_cpuHz() {
 		static int failed{}; // defaults to 0
 
@@ -416,28 +679,22 @@ namespace Cpu {
 		string cpuhz;
 		try {
 			double hz{}; // defaults to 0.0
-			//? Try to get freq from /sys/devices/system/cpu/cpufreq/policy first (faster)
-			if (not freq_path.empty()) {
+			//? Use frequency of the first core if per core frequencies are shown, read from already open inputs
+			if (has_core_freq and Config::getB("show_core_freq") and not current_cpu.core_freq.empty() and not current_cpu.core_freq[0].empty())
+				hz = current_cpu.core_freq[0].back();
+
+			//? Try to get freq from /sys/devices/system/cpu/cpufreq/policy next (faster)
+			if (hz <= 0.0 and not freq_path.empty()) {
 				hz = stod(readfile(freq_path, "0.0")) / 1000;
 				if (hz <= 0.0 and ++failed >= 2)
 					freq_path.clear();
 			}
 			//? If freq from /sys failed or is missing try to use /proc/cpuinfo
 			if (hz <= 0.0) {
-				ifstream cpufreq(Shared::procPath / "cpuinfo");
-				if (cpufreq.good()) {
-					while (cpufreq.ignore(SSmax, '\n')) {
-						if (cpufreq.peek() == 'c') {
-							cpufreq.ignore(SSmax, ' ');
-							if (cpufreq.peek() == 'M') {
-								cpufreq.ignore(SSmax, ':');
-								cpufreq.ignore(1);
-								cpufreq >> hz;
-								break;
-							}
-						}
-					}
-				}
+				auto cpuinfo = Shared::proc_dir.read("cpuinfo");
+				const auto mhz = cpuinfo_value(cpuinfo, "cpu MHz");
+				//? Buffer is null terminated so strtod stops at the end of the file at most
+				if (not mhz.empty()) hz = std::strtod(mhz.data(), nullptr);
 			}
 
 			if (hz <= 1 or hz >= 1000000)
@@ -469,28 +726,25 @@ namespace Cpu {
 		if (cpu_temp_only) return core_map;
 
 		//? Try to get core mapping from /proc/cpuinfo
-		ifstream cpuinfo(Shared::procPath / "cpuinfo");
-		if (cpuinfo.good()) {
-			int cpu{};  // defaults to 0
-			int core{}; // defaults to 0
-			int n{};    // defaults to 0
-			for (string instr; cpuinfo >> instr;) {
-				if (instr == "processor") {
-					cpuinfo.ignore(SSmax, ':');
-					cpuinfo >> cpu;
-				}
-				else if (instr.starts_with("core")) {
-					cpuinfo.ignore(SSmax, ':');
-					cpuinfo >> core;
-					if (std::cmp_greater_equal(core, core_sensors.size())) {
-						if (std::cmp_greater_equal(n, core_sensors.size())) n = 0;
-						core_map[cpu] = n++;
-					}
-					else
-						core_map[cpu] = core;
-				}
-				cpuinfo.ignore(SSmax, '\n');
+		auto cpuinfo = Shared::proc_dir.read("cpuinfo");
+		int cpu{};  // defaults to 0
+		int n{};    // defaults to 0
+		while (not cpuinfo.empty()) {
+			auto line = next_token(cpuinfo, '\n');
+			const bool processor = line.starts_with("processor");
+			if (not processor and not line.starts_with("core")) continue;
+			const auto colon = line.find(':');
+			if (colon == std::string_view::npos) continue;
+			line.remove_prefix(colon + 1);
+			const int value = sv_to<int>(next_token(line, " \t"));
+			if (processor)
+				cpu = value;
+			else if (std::cmp_greater_equal(value, core_sensors.size())) {
+				if (std::cmp_greater_equal(n, core_sensors.size())) n = 0;
+				core_map[cpu] = n++;
 			}
+			else
+				core_map[cpu] = value;
 		}
 
 		//? If core mapping from cpuinfo was incomplete try to guess remainder, if missing completely, map 0-0 1-1 2-2 etc.
@@ -667,9 +921,20 @@ namespace Cpu {
 	}
 
 	auto collect(bool no_update) -> cpu_info& {
-		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty())) return current_cpu;
+		if (Runner::stopping or (no_update and not current_cpu.cpu_percent[field::total].empty())) return current_cpu;
 		auto& cpu = current_cpu;
 
+		if (Config::getB("show_core_freq")) {
+			//? Inputs of new cores and of cores that had none are opened again, the box is resized if any core has an input now
+			if (core_freq_retry or cmp_less(core_freq_fds.size(), Shared::coreCount)) {
+				const bool had_core_freq = has_core_freq;
+				has_core_freq = open_core_freq(cpu, core_freq_retry);
+				core_freq_retry = false;
+				if (has_core_freq != had_core_freq) Runner::coreNum_reset = true;
+			}
+			if (has_core_freq) update_core_freq(cpu);
+		}
+
 		if (Config::getB("show_cpu_freq"))
 			cpuHz = get_cpuHz();
 
@@ -677,110 +942,104 @@ namespace Cpu {
 			Logger::error("failed to get load averages");
 		}
 
-		ifstream cread;
-
 		try {
-			//? Get cpu total times for all cores from /proc/stat
-			string cpu_name;
-			cread.open(Shared::procPath / "stat");
-			int i = 0;
-			int target = Shared::coreCount;
-			for (; i <= target or (cread.good() and cread.peek() == 'c'); i++) {
-				//? Make sure to add zero value for missing core values if at end of file
-				if ((not cread.good() or cread.peek() != 'c') and i <= target) {
-					if (i == 0) throw std::runtime_error("Failed to parse /proc/stat");
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						cpu.core_percent.at(i-1).push_back(0);
-					}
-				}
-				else {
-					if (i == 0) cread.ignore(SSmax, ' ');
-					else {
-						cread >> cpu_name;
-						int cpuNum = std::stoi(cpu_name.substr(3));
-						if (cpuNum >= target - 1) target = cpuNum + (cread.peek() == 'c' ? 2 : 1);
-
-						//? Add zero value for core if core number is missing from /proc/stat
-						while (i - 1 < cpuNum) {
-							//? Fix container sizes if new cores are detected
-							while (cmp_less(cpu.core_percent.size(), i)) {
-								core_old_totals.push_back(0);
-								core_old_idles.push_back(0);
-								cpu.core_percent.emplace_back();
-							}
-							cpu.core_percent[i-1].push_back(0);
-							if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
-							i++;
-						}
-					}
-
-					//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
-					vector<long long> times;
-					long long total_sum = 0;
-
-					for (uint64_t val; cread >> val; total_sum += val) {
-						times.push_back(val);
-					}
-					cread.clear();
-					if (times.size() < 4) throw std::runtime_error("Malformed /proc/stat");
+			//? Get cpu total times for all cores from the shared /proc/stat snapshot
+			if (not Shared::proc_stat.get(Shared::ProcStat::cpu)) throw std::runtime_error("Failed to read /proc/stat");
+			const auto& stat = Shared::proc_stat;
+			if (stat.total.fields < 4) throw std::runtime_error("Failed to parse /proc/stat");
+
+			//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
+			//? Fields 8-9 are already included in user and nice and any future unknown fields are ignored
+			const auto totals_of = [](const Shared::cpu_times& t) { return max(0ll, t.sum(0, 8)); };
+
+			//? Add iowait field if present
+			const auto idles_of = [](const Shared::cpu_times& t) { return max(0ll, t.sum(3, 5)); };
+
+			//? Calculate values for totals from first line of stat
+			{
+				const long long totals = totals_of(stat.total);
+				const long long idles = idles_of(stat.total);
+				const long long calc_totals = max(1ll, totals - old_totals);
+				const long long calc_idles = max(1ll, idles - old_idles);
+				old_totals = totals;
+				old_idles = idles;
+
+				//? Total usage of cpu
+				cpu.cpu_percent[field::total].push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
 
-					//? Subtract fields 8-9 and any future unknown fields
-					const long long totals = max(0ll, total_sum - (times.size() > 8 ? std::accumulate(times.begin() + 8, times.end(), 0ll) : 0));
-
-					//? Add iowait field if present
-					const long long idles = max(0ll, times.at(3) + (times.size() > 4 ? times.at(4) : 0));
-
-					//? Calculate values for totals from first line of stat
-					if (i == 0) {
-						const long long calc_totals = max(1ll, totals - cpu_old.at("totals"));
-						const long long calc_idles = max(1ll, idles - cpu_old.at("idles"));
-						cpu_old.at("totals") = totals;
-						cpu_old.at("idles") = idles;
-
-						//? Total usage of cpu
-						cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+				//? Reduce size if there are more values than needed for graph
+				while (cmp_greater(cpu.cpu_percent[field::total].size(), width * 2)) cpu.cpu_percent[field::total].pop_front();
 
-						//? Reduce size if there are more values than needed for graph
-						while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
+				//? Populate cpu.cpu_percent with all fields from stat
+				for (size_t ii = 0; ii < stat.total.fields; ii++) {
+					auto& history = cpu.cpu_percent[static_cast<field>(ii + 1)];
+					const long long val = stat.total.times[ii];
+					history.push_back(clamp((long long)round((double)(val - old_times[ii]) * 100 / calc_totals), 0ll, 100ll));
+					old_times[ii] = val;
 
-						//? Populate cpu.cpu_percent with all fields from stat
-						for (int ii = 0; const auto& val : times) {
-							cpu.cpu_percent.at(time_names.at(ii)).push_back(clamp((long long)round((double)(val - cpu_old.at(time_names.at(ii))) * 100 / calc_totals), 0ll, 100ll));
-							cpu_old.at(time_names.at(ii)) = val;
+					//? Reduce size if there are more values than needed for graph
+					while (cmp_greater(history.size(), width * 2)) history.pop_front();
+				}
+			}
 
-							//? Reduce size if there are more values than needed for graph
-							while (cmp_greater(cpu.cpu_percent.at(time_names.at(ii)).size(), width * 2)) cpu.cpu_percent.at(time_names.at(ii)).pop_front();
+			//? Cpu total for each core, cores missing from /proc/stat (offline) get a zero value
+			long target = Shared::coreCount;
+			for (size_t c = 0; c < stat.core_count; c++) {
+				if (stat.cores[c].num < 0 or stat.cores[c].fields < 4) throw std::runtime_error("Malformed /proc/stat");
+				target = max(target, (long)stat.cores[c].num + 1);
+			}
 
-							if (++ii == 10) break;
-						}
-						continue;
-					}
-					//? Calculate cpu total for each core
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						const long long calc_totals = max(0ll, totals - core_old_totals.at(i-1));
-						const long long calc_idles = max(0ll, idles - core_old_idles.at(i-1));
-						core_old_totals.at(i-1) = totals;
-						core_old_idles.at(i-1) = idles;
+			//? Fix container sizes if new cores are detected
+			while (cmp_less(cpu.core_percent.size(), target)) {
+				core_old_totals.push_back(0);
+				core_old_idles.push_back(0);
+				cpu.core_percent.emplace_back();
+			}
 
-						cpu.core_percent.at(i-1).push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
-					}
+			size_t next = 0;
+			for (int core = 0; core < target; core++) {
+				while (next < stat.core_count and stat.cores[next].num < core) next++;
+				auto& history = cpu.core_percent.at(core);
+				if (next < stat.core_count and stat.cores[next].num == core) {
+					const auto& entry = stat.cores[next++];
+					const long long totals = totals_of(entry);
+					const long long idles = idles_of(entry);
+					const long long calc_totals = max(0ll, totals - core_old_totals.at(core));
+					const long long calc_idles = max(0ll, idles - core_old_idles.at(core));
+					core_old_totals.at(core) = totals;
+					core_old_idles.at(core) = idles;
+
+					history.push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
 				}
+				else history.push_back(0);
 
 				//? Reduce size if there are more values than needed for graph
-				if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
+				if (history.size() > 40) history.pop_front();
+			}
+
+			//? Frequency inputs missing for some cores are retried when the set of online cores changes
+			static size_t old_online{}; // defaults to 0
+			size_t online = 0;
+			for (size_t c = 0; c < stat.core_count; c++) online = online * 31 + stat.cores[c].num + 1;
+			if (online != old_online) {
+				if (old_online > 0) core_freq_retry = true;
+				old_online = online;
+			}
+
+			//? Scheduler activity, context switches and interrupts as rates per second and task counts as is
+			static uint64_t old_ctxt{}, old_intr{}, old_timestamp{};
+			if (old_timestamp > 0 and stat.timestamp > old_timestamp) {
+				const double seconds = (stat.timestamp - old_timestamp) / 1000.0;
+				cpu.sched_stats[sched_field::ctxt].push_back(round((stat.ctxt - min(old_ctxt, stat.ctxt)) / seconds));
+				cpu.sched_stats[sched_field::intr].push_back(round((stat.intr - min(old_intr, stat.intr)) / seconds));
+				cpu.sched_stats[sched_field::running].push_back(stat.procs_running);
+				cpu.sched_stats[sched_field::blocked].push_back(stat.procs_blocked);
+				for (auto& history : cpu.sched_stats)
+					while (cmp_greater(history.size(), width * 2)) history.pop_front();
 			}
+			old_ctxt = stat.ctxt;
+			old_intr = stat.intr;
+			old_timestamp = stat.timestamp;
 
 			//? Notify main thread to redraw screen if we found more cores than previously detected
 			if (cmp_greater(cpu.core_percent.size(), Shared::coreCount)) {
@@ -793,8 +1052,7 @@ namespace Cpu {
 		}
 		catch (const std::exception& e) {
 			Logger::debug("Cpu::collect() : " + string{e.what()});
-			if (cread.bad()) throw std::runtime_error("Failed to read /proc/stat");
-			else throw std::runtime_error("Cpu::collect() : " + string{e.what()});
+			throw std::runtime_error("Cpu::collect() : " + string{e.what()});
 		}
 
 		if (Config::getB("check_temp") and got_sensors)
@@ -817,27 +1075,331 @@ namespace Mem {
 	//?* Find the filepath to the specified ZFS object's stat file
 	fs::path get_zfs_stat_file(const string& device_name, size_t dataset_name_start, bool zfs_hide_datasets);
 
-	//?* Collect total ZFS pool io stats
-	bool zfs_collect_pool_total_stats(struct disk_info &disk);
+	//?* Collect ZFS io stats, summed over all objsets of the pool if <pool_total> is true
+	bool zfs_collect_stats(struct disk_info &disk, bool pool_total);
 
 	mem_info current_mem {};
 
+	//* Runs statvfs() for mountpoints on detached helper threads so a hung network filesystem can't block the runner.
+	//* Each mountpoint has at most one call running, a call still running after its deadline leaves the mountpoint stale
+	//* and later calls are delayed with an exponential backoff, a call that never returns only ever occupies one helper
+	//* and at most max_helpers helpers are started
+	class VfsStats {
+		struct vfs_call {
+			string mountpoint;
+			struct statvfs vfs{};
+			int error{};        // defaults to 0
+			bool done{};        // defaults to false
+		};
+
+		//? Shared with the detached helpers, which keep their own reference
+		struct helper_state {
+			std::mutex mtx;
+			std::condition_variable work_cv, done_cv;
+			deque<std::shared_ptr<vfs_call>> queue;
+			size_t idle{};      // defaults to 0
+			size_t helpers{};   // helpers started, they never exit, defaults to 0
+		};
+
+		//? Most helpers started in total, calls queued while all of them are busy or hung wait for one to be free
+		static constexpr size_t max_helpers = 8;
+
+		struct mount_state {
+			std::shared_ptr<vfs_call> running;
+			struct statvfs vfs{};
+			uint64_t started{};     // defaults to 0
+			uint64_t retry_at{};    // defaults to 0
+			uint8_t backoff{};      // defaults to 0
+			bool valid{};           // defaults to false
+			bool timed_out{};       // defaults to false
+		};
+
+		std::shared_ptr<helper_state> state = std::make_shared<helper_state>();
+		unordered_flat_map<string, mount_state> mounts;
+		vector<std::shared_ptr<vfs_call>> started;
+
+		static void helper_loop(std::shared_ptr<helper_state> st) {
+			for (;;) {
+				std::shared_ptr<vfs_call> req;
+				{
+					std::unique_lock lck(st->mtx);
+					st->idle++;
+					st->work_cv.wait(lck, [&]{ return not st->queue.empty(); });
+					st->idle--;
+					req = std::move(st->queue.front());
+					st->queue.pop_front();
+				}
+				struct statvfs vfs;
+				const int error = (statvfs(req->mountpoint.c_str(), &vfs) < 0 ? errno : 0);
+				{
+					std::lock_guard lck(st->mtx);
+					req->vfs = vfs;
+					req->error = error;
+					req->done = true;
+				}
+				st->done_cv.notify_all();
+			}
+		}
+	public:
+		enum class result { Done, Failed, Missing, Pending, Stale };
+
+		//* Start statvfs() for <mountpoint> unless a call is still running or it is backing off after a timeout
+		//* A call queued behind busy helpers times out like a hung call, so the mountpoint shows its last values as stale
+		void request(const string& mountpoint) {
+			auto& mount = mounts[mountpoint];
+			if (mount.running != nullptr or time_ms() < mount.retry_at) return;
+			auto req = std::make_shared<vfs_call>();
+			req->mountpoint = mountpoint;
+			{
+				std::lock_guard lck(state->mtx);
+				if (state->idle <= state->queue.size() and state->helpers < max_helpers) {
+					try { std::thread(helper_loop, state).detach(); }
+					catch (const std::system_error&) { return; }
+					state->helpers++;
+				}
+				state->queue.push_back(req);
+			}
+			state->work_cv.notify_one();
+			mount.running = req;
+			mount.started = time_ms();
+			started.push_back(std::move(req));
+		}
+
+		//* Wait until all calls started since last wait are done or <deadline> milliseconds after they were started
+		void wait(const uint64_t deadline) {
+			if (started.empty()) return;
+			std::unique_lock lck(state->mtx);
+			state->done_cv.wait_for(lck, std::chrono::milliseconds(deadline), [&]{
+				return rng::all_of(started, [](const auto& req) { return req->done; });
+			});
+			started.clear();
+		}
+
+		//* Get result for <mountpoint>, <vfs> is set to the last values returned for Done and Stale, Pending if no values yet
+		result get(const string& mountpoint, struct statvfs& vfs, int& error, const uint64_t deadline) {
+			auto& mount = mounts[mountpoint];
+			if (mount.running != nullptr) {
+				std::unique_lock lck(state->mtx);
+				if (mount.running->done) {
+					const auto req = std::move(mount.running);
+					lck.unlock();
+					error = req->error;
+					if (mount.timed_out) {
+						mount.retry_at = time_ms() + min((uint64_t)1000 << min(mount.backoff++, (uint8_t)6), (uint64_t)60'000);
+						mount.timed_out = false;
+					}
+					else
+						mount.backoff = 0;
+					if (error == ENOENT) return result::Missing;
+					if (error != 0) return result::Failed;
+					mount.vfs = req->vfs;
+					mount.valid = true;
+					vfs = mount.vfs;
+					return (mount.backoff > 0 ? result::Stale : result::Done);
+				}
+				else if (not mount.timed_out and time_ms() - mount.started >= deadline) {
+					mount.timed_out = true;
+					Logger::debug("statvfs() for mount \"" + mountpoint + "\" timed out, showing last values.");
+				}
+			}
+			if (not mount.valid) return (mount.running != nullptr ? result::Pending : result::Missing);
+			vfs = mount.vfs;
+			return (mount.timed_out or mount.backoff > 0 ? result::Stale : result::Done);
+		}
+
+		//* Forget mountpoints not in <keep>, calls still running are left to finish
+		void cleanup(const auto& keep) {
+			for (auto it = mounts.begin(); it != mounts.end();) {
+				if (not keep.contains(it->first)) it = mounts.erase(it);
+				else it++;
+			}
+		}
+	};
+
+	VfsStats vfs_stats;
+
+	//* Keeps the objset kstat files of ZFS pools open between updates instead of scanning the pool directories every tick.
+	//* A pool directory is only listed again when its mtime changes, a read fails, a dataset lookup misses or after relist_ms,
+	//* files still present keep their descriptor and at most max_open files are kept open, the rest are opened per read
+	class ZfsKstats {
+	public:
+		struct counters {
+			int64_t reads{};      // defaults to 0
+			int64_t writes{};     // defaults to 0
+			int64_t nread{};      // defaults to 0
+			int64_t nwritten{};   // defaults to 0
+		};
+	private:
+		struct objset {
+			string name;
+			int fd{-1};
+		};
+
+		struct pool {
+			unordered_flat_map<string, objset> objsets; // keyed by file path
+			struct timespec mtime{};
+			uint64_t listed{};      // defaults to 0
+			bool dirty{true};
+		};
+
+		static constexpr uint64_t relist_ms = 10'000;
+		static constexpr size_t max_open = 512;
+		unordered_flat_map<string, pool> pools; // keyed by pool kstat directory
+		size_t open_count{};    // defaults to 0
+		string buffer;
+
+		void close_objset(objset& obj) {
+			if (obj.fd < 0) return;
+			close(obj.fd);
+			obj.fd = -1;
+			open_count--;
+		}
+
+		//* List objset files in <dir> if needed, keeping descriptors of files that are still present
+		pool& refresh(const string& dir) {
+			auto& p = pools[dir];
+			struct stat dir_stat;
+			if (::stat(dir.c_str(), &dir_stat) != 0) {
+				for (auto& [path, obj] : p.objsets) close_objset(obj);
+				p.objsets.clear();
+				p.dirty = true;
+				return p;
+			}
+			const bool mtime_changed = (dir_stat.st_mtim.tv_sec != p.mtime.tv_sec or dir_stat.st_mtim.tv_nsec != p.mtime.tv_nsec);
+			if (not p.dirty and not mtime_changed and time_ms() - p.listed < relist_ms) return p;
+
+			unordered_flat_map<string, objset> listed;
+			std::error_code ec;
+			for (const auto& file : fs::directory_iterator(dir, ec)) {
+				if (not file.path().filename().string().starts_with("objset")) continue;
+				auto path = file.path().string();
+				if (auto old = p.objsets.find(path); old != p.objsets.end()) {
+					listed[path] = std::move(old->second);
+					p.objsets.erase(old);
+				}
+				else {
+					auto& obj = listed[path];
+					if (open_count < max_open and (obj.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC)) >= 0) open_count++;
+				}
+			}
+			if (ec) Logger::debug("Could not read directory: " + dir);
+			for (auto& [path, obj] : p.objsets) close_objset(obj);
+			p.objsets = std::move(listed);
+			p.mtime = dir_stat.st_mtim;
+			p.listed = time_ms();
+			p.dirty = false;
+			return p;
+		}
+
+		//* Read and parse objset file <path>, using the cached descriptor if there is one
+		bool read(const string& path, objset& obj, counters& out) {
+			const int fd = (obj.fd >= 0 ? obj.fd : open(path.c_str(), O_RDONLY | O_CLOEXEC));
+			if (fd < 0) return false;
+			if (buffer.size() < 4096) buffer.resize(4096);
+			size_t len = 0;
+			for (;;) {
+				if (len + 1 >= buffer.size()) buffer.resize(buffer.size() * 2);
+				const ssize_t got = pread(fd, buffer.data() + len, buffer.size() - len - 1, len);
+				if (got < 0 and errno == EINTR) continue;
+				if (got <= 0) break;
+				len += got;
+			}
+			if (obj.fd < 0) close(fd);
+			if (len == 0) return false;
+
+			//? Skip kstat header and column names, remaining lines are "<name> <type> <value>"
+			std::string_view content{buffer.data(), len};
+			next_token(content, '\n');
+			next_token(content, '\n');
+			out = {};
+			bool found{};   // defaults to false
+			while (not content.empty()) {
+				auto line = next_token(content, '\n');
+				const auto name = next_token(line);
+				next_token(line);
+				const auto value = next_token(line);
+				if (name == "dataset_name") obj.name = value;
+				else if (name == "reads") out.reads = sv_to<int64_t>(value);
+				else if (name == "writes") out.writes = sv_to<int64_t>(value);
+				else if (name == "nread") out.nread = sv_to<int64_t>(value);
+				else if (name == "nwritten") { out.nwritten = sv_to<int64_t>(value); found = true; }
+			}
+			return found;
+		}
+
+	public:
+		ZfsKstats() = default;
+		ZfsKstats(const ZfsKstats&) = delete;
+		ZfsKstats& operator=(const ZfsKstats&) = delete;
+		~ZfsKstats() {
+			for (auto& [dir, p] : pools)
+				for (auto& [path, obj] : p.objsets) close_objset(obj);
+		}
+
+		//* Return path of the objset file for dataset <name> in pool directory <dir>, empty if not found
+		string find(const string& dir, const string& name) {
+			counters unused;
+			for (int attempt = 0; attempt < 2; attempt++) {
+				auto& p = refresh(dir);
+				for (auto& [path, obj] : p.objsets) {
+					if (obj.name.empty()) read(path, obj, unused);
+					if (obj.name == name) return path;
+				}
+				if (p.dirty) break;
+				p.dirty = true;
+			}
+			return "";
+		}
+
+		//* Sum counters of all objsets in pool directory <dir>, returns false if none could be read
+		bool totals(const string& dir, counters& out) {
+			auto& p = refresh(dir);
+			out = {};
+			size_t objects_read{};  // defaults to 0
+			for (auto& [path, obj] : p.objsets) {
+				counters objset_counters;
+				if (not read(path, obj, objset_counters)) {
+					p.dirty = true;
+					continue;
+				}
+				out.reads += objset_counters.reads;
+				out.writes += objset_counters.writes;
+				out.nread += objset_counters.nread;
+				out.nwritten += objset_counters.nwritten;
+				objects_read++;
+			}
+			return objects_read > 0;
+		}
+
+		//* Read counters of a single objset file, returns false if it could not be read
+		bool single(const fs::path& path, counters& out) {
+			auto& p = refresh(path.parent_path().string());
+			auto obj = p.objsets.find(path.string());
+			if (obj == p.objsets.end() or not read(obj->first, obj->second, out)) {
+				p.dirty = true;
+				return false;
+			}
+			return true;
+		}
+	};
+
+	ZfsKstats zfs_kstats;
+
 	uint64_t get_totalMem() {
-		ifstream meminfo(Shared::procPath / "meminfo");
-		int64_t totalMem;
-		if (meminfo.good()) {
-			meminfo.ignore(SSmax, ':');
-			meminfo >> totalMem;
-			totalMem <<= 10;
-		}
-		if (not meminfo.good() or totalMem == 0)
+		auto meminfo = Shared::proc_dir.read("meminfo", 128);
+		uint64_t totalMem = 0;
+		if (const auto pos = meminfo.find(':'); pos != std::string_view::npos) {
+			meminfo.remove_prefix(pos + 1);
+			totalMem = sv_to<uint64_t>(next_token(meminfo)) << 10;
+		}
+		if (totalMem == 0)
 			throw std::runtime_error("Could not get total memory size from /proc/meminfo");
 
 		return totalMem;
 	}
 
 	auto collect(bool no_update) -> mem_info& {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty())) return current_mem;
+		if (Runner::stopping or (no_update and not current_mem.percent[field::used].empty())) return current_mem;
 		auto show_swap = Config::getB("show_swap");
 		auto swap_disk = Config::getB("swap_disk");
 		auto show_disks = Config::getB("show_disks");
@@ -845,81 +1407,77 @@ namespace Mem {
 		auto totalMem = get_totalMem();
 		auto& mem = current_mem;
 
-		mem.stats.at("swap_total") = 0;
+		mem.stats[field::swap_total] = 0;
 
 		//? Read ZFS ARC info from /proc/spl/kstat/zfs/arcstats
 		uint64_t arc_size = 0, arc_min_size = 0;
 		if (zfs_arc_cached) {
-			ifstream arcstats(Shared::procPath / "spl/kstat/zfs/arcstats");
-			if (arcstats.good()) {
-				for (string label; arcstats >> label;) {
-					if (label == "c_min") {
-						arcstats >> arc_min_size >> arc_min_size; // double read skips type column
-					}
-					else if (label == "size") {
-						arcstats >> arc_size >> arc_size;
-						break;
-					}
+			auto arcstats = Shared::proc_dir.read("spl/kstat/zfs/arcstats");
+			while (not arcstats.empty()) {
+				auto line = next_token(arcstats, '\n');
+				const auto label = next_token(line);
+				if (label == "c_min") {
+					next_token(line); // skip type column
+					arc_min_size = sv_to<uint64_t>(next_token(line));
+				}
+				else if (label == "size") {
+					next_token(line);
+					arc_size = sv_to<uint64_t>(next_token(line));
+					break;
 				}
 			}
-			arcstats.close();
 		}
 
 		//? Read memory info from /proc/meminfo
-		ifstream meminfo(Shared::procPath / "meminfo");
-		if (meminfo.good()) {
+		auto meminfo = Shared::proc_dir.read("meminfo");
+		if (not meminfo.empty()) {
 			bool got_avail = false;
-			for (string label; meminfo.peek() != 'D' and meminfo >> label;) {
+			while (not meminfo.empty() and meminfo.front() != 'D') {
+				auto line = next_token(meminfo, '\n');
+				const auto label = next_token(line);
+				const uint64_t value = sv_to<uint64_t>(next_token(line)) << 10;
 				if (label == "MemFree:") {
-					meminfo >> mem.stats.at("free");
-					mem.stats.at("free") <<= 10;
+					mem.stats[field::free] = value;
 				}
 				else if (label == "MemAvailable:") {
-					meminfo >> mem.stats.at("available");
-					mem.stats.at("available") <<= 10;
+					mem.stats[field::available] = value;
 					got_avail = true;
 				}
 				else if (label == "Cached:") {
-					meminfo >> mem.stats.at("cached");
-					mem.stats.at("cached") <<= 10;
+					mem.stats[field::cached] = value;
 					if (not show_swap and not swap_disk) break;
 				}
 				else if (label == "SwapTotal:") {
-					meminfo >> mem.stats.at("swap_total");
-					mem.stats.at("swap_total") <<= 10;
+					mem.stats[field::swap_total] = value;
 				}
 				else if (label == "SwapFree:") {
-					meminfo >> mem.stats.at("swap_free");
-					mem.stats.at("swap_free") <<= 10;
+					mem.stats[field::swap_free] = value;
 					break;
 				}
-				meminfo.ignore(SSmax, '\n');
 			}
-			if (not got_avail) mem.stats.at("available") = mem.stats.at("free") + mem.stats.at("cached");
+			if (not got_avail) mem.stats[field::available] = mem.stats[field::free] + mem.stats[field::cached];
 			if (zfs_arc_cached) {
-				mem.stats.at("cached") += arc_size;
+				mem.stats[field::cached] += arc_size;
 				// The ARC will not shrink below arc_min_size, so that memory is not available
 				if (arc_size > arc_min_size)
-					mem.stats.at("available") += arc_size - arc_min_size;
+					mem.stats[field::available] += arc_size - arc_min_size;
 			}
-			mem.stats.at("used") = totalMem - (mem.stats.at("available") <= totalMem ? mem.stats.at("available") : mem.stats.at("free"));
+			mem.stats[field::used] = totalMem - (mem.stats[field::available] <= totalMem ? mem.stats[field::available] : mem.stats[field::free]);
 
-			if (mem.stats.at("swap_total") > 0) mem.stats.at("swap_used") = mem.stats.at("swap_total") - mem.stats.at("swap_free");
+			if (mem.stats[field::swap_total] > 0) mem.stats[field::swap_used] = mem.stats[field::swap_total] - mem.stats[field::swap_free];
 		}
 		else
 			throw std::runtime_error("Failed to read /proc/meminfo");
 
-		meminfo.close();
-
 		//? Calculate percentages
 		for (const auto& name : mem_names) {
 			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / totalMem));
 			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
 		}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
+		if (show_swap and mem.stats[field::swap_total] > 0) {
 			for (const auto& name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
+				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats[field::swap_total]));
 				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
 			}
 			has_swap = true;
@@ -939,7 +1497,6 @@ namespace Mem {
 				auto only_physical = Config::getB("only_physical");
 				auto zfs_hide_datasets = Config::getB("zfs_hide_datasets");
 				auto& disks = mem.disks;
-				ifstream diskread;
 
 				vector<string> filter;
 				if (not disks_filter.empty()) {
@@ -954,53 +1511,53 @@ namespace Mem {
 				vector<string> fstypes;
 				if (only_physical and not use_fstab) {
 					fstypes = {"zfs", "wslfs", "drvfs"};
-					diskread.open(Shared::procPath / "filesystems");
-					if (diskread.good()) {
-						for (string fstype; diskread >> fstype;) {
-							if (not is_in(fstype, "nodev", "squashfs", "nullfs"))
-								fstypes.push_back(fstype);
-							diskread.ignore(SSmax, '\n');
-						}
-					}
-					else
+					auto filesystems = Shared::proc_dir.read("filesystems");
+					if (filesystems.empty())
 						throw std::runtime_error("Failed to read /proc/filesystems");
-					diskread.close();
+					while (not filesystems.empty()) {
+						auto line = next_token(filesystems, '\n');
+						const auto fstype = next_token(line, " \t");
+						if (not fstype.empty() and not is_in(fstype, "nodev", "squashfs", "nullfs"))
+							fstypes.emplace_back(fstype);
+					}
 				}
 
 				//? Get disk list to use from fstab if enabled
 				if (use_fstab and fs::last_write_time("/etc/fstab") != fstab_time) {
 					fstab.clear();
 					fstab_time = fs::last_write_time("/etc/fstab");
-					diskread.open("/etc/fstab");
-					if (diskread.good()) {
-						for (string instr; diskread >> instr;) {
-							if (not instr.starts_with('#')) {
-								diskread >> instr;
-								#ifdef SNAPPED
-									if (instr == "/") fstab.push_back("/mnt");
-									else if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
-								#else
-									if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
-								#endif
-							}
-							diskread.ignore(SSmax, '\n');
-						}
-					}
-					else
+					string fstab_file;
+					if (not Shared::proc_dir.read("/etc/fstab", fstab_file))
 						throw std::runtime_error("Failed to read /etc/fstab");
-					diskread.close();
+					for (std::string_view rest = fstab_file; not rest.empty();) {
+						auto line = next_token(rest, '\n');
+						const auto first = next_token(line, " \t");
+						if (first.empty() or first.starts_with('#')) continue;
+						const string instr{next_token(line, " \t")};
+						#ifdef SNAPPED
+							if (instr == "/") fstab.push_back("/mnt");
+							else if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
+						#else
+							if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
+						#endif
+					}
 				}
 
-				//? Get mounts from /etc/mtab or /proc/self/mounts
-				diskread.open((fs::exists("/etc/mtab") ? fs::path("/etc/mtab") : Shared::procPath / "self/mounts"));
-				if (diskread.good()) {
+				static const bool has_diskstats = (access((Shared::procPath / "diskstats").c_str(), R_OK) == 0);
+
+				//? Get mounts from /etc/mtab or /proc/self/mounts, kept in a separate buffer since disks lookups below can read other files
+				static string mounts;
+				if (Shared::proc_dir.read((fs::exists("/etc/mtab") ? "/etc/mtab" : "self/mounts"), mounts)) {
 					vector<string> found;
 					found.reserve(last_found.size());
 					string dev, mountpoint, fstype;
-					while (not diskread.eof()) {
+					for (std::string_view rest = mounts; not rest.empty();) {
 						std::error_code ec;
-						diskread >> dev >> mountpoint >> fstype;
-						diskread.ignore(SSmax, '\n');
+						auto line = next_token(rest, '\n');
+						dev = next_token(line, " \t");
+						mountpoint = next_token(line, " \t");
+						fstype = next_token(line, " \t");
+						if (fstype.empty()) continue;
 
 						if (v_contains(ignore_list, mountpoint) or v_contains(found, mountpoint)) continue;
 
@@ -1029,9 +1586,13 @@ namespace Mem {
 									if (mountpoint == "/mnt") disks.at(mountpoint).name = "root";
 								#endif
 								if (disks.at(mountpoint).name.empty()) disks.at(mountpoint).name = (mountpoint == "/" ? "root" : mountpoint);
+								//? Block devices are looked up by major:minor in /proc/diskstats, other disks use their /sys/block stat file
+								struct stat dev_stat;
+								if (fstype != "zfs" and has_diskstats and ::stat(disks.at(mountpoint).dev.c_str(), &dev_stat) == 0 and S_ISBLK(dev_stat.st_mode))
+									disks.at(mountpoint).devno = dev_stat.st_rdev;
 								string devname = disks.at(mountpoint).dev.filename();
 								int c = 0;
-								while (devname.size() >= 2) {
+								while (disks.at(mountpoint).devno == 0 and devname.size() >= 2) {
 									if (fs::exists("/sys/block/" + devname + "/stat", ec) and access(string("/sys/block/" + devname + "/stat").c_str(), R_OK) == 0) {
 										if (c > 0 and fs::exists("/sys/block/" + devname + '/' + disks.at(mountpoint).dev.filename().string() + "/stat", ec))
 											disks.at(mountpoint).stat = "/sys/block/" + devname + '/' + disks.at(mountpoint).dev.filename().string() + "/stat";
@@ -1075,15 +1636,23 @@ namespace Mem {
 				}
 				else
 					throw std::runtime_error("Failed to get mounts from /etc/mtab and /proc/self/mounts");
-				diskread.close();
 
-				//? Get disk/partition stats
+				//? Get disk/partition stats, statvfs() is called on helper threads and waited on for at most disk_timeout_ms
 				bool new_ignored = false;
+				const uint64_t disk_timeout = Config::getI("disk_timeout_ms");
+				for (const auto& [mountpoint, disk] : disks) {
+					if (mountpoint != "swap" and not v_contains(ignore_list, mountpoint)) vfs_stats.request(mountpoint);
+				}
+				vfs_stats.wait(disk_timeout);
 				for (auto& [mountpoint, disk] : disks) {
-					if (std::error_code ec; not fs::exists(mountpoint, ec) or v_contains(ignore_list, mountpoint)) continue;
-					struct statvfs vfs;
-					if (statvfs(mountpoint.c_str(), &vfs) < 0) {
-						Logger::warning("Failed to get disk/partition stats for mount \""+ mountpoint + "\" with statvfs error code: " + to_string(errno) + ". Ignoring...");
+					if (mountpoint == "swap" or v_contains(ignore_list, mountpoint)) continue;
+					struct statvfs vfs{};
+					int error = 0;
+					const auto status = vfs_stats.get(mountpoint, vfs, error, disk_timeout);
+					disk.stale = (status == VfsStats::result::Stale or status == VfsStats::result::Pending);
+					if (status == VfsStats::result::Missing or status == VfsStats::result::Pending) continue;
+					if (status == VfsStats::result::Failed) {
+						Logger::warning("Failed to get disk/partition stats for mount \""+ mountpoint + "\" with statvfs error code: " + to_string(error) + ". Ignoring...");
 						ignore_list.push_back(mountpoint);
 						new_ignored = true;
 						continue;
@@ -1095,6 +1664,8 @@ namespace Mem {
 					disk.free_percent = 100 - disk.used_percent;
 				}
 
+				vfs_stats.cleanup(disks);
+
 				//? Remove any problematic disks added to the ignore_list
 				if (new_ignored) {
 					for (auto it = disks.begin(); it != disks.end();) {
@@ -1115,11 +1686,11 @@ namespace Mem {
 				if (swap_disk and has_swap) {
 					mem.disks_order.push_back("swap");
 					if (not disks.contains("swap")) disks["swap"] = {"", "swap", "swap"};
-					disks.at("swap").total = mem.stats.at("swap_total");
-					disks.at("swap").used = mem.stats.at("swap_used");
-					disks.at("swap").free = mem.stats.at("swap_free");
-					disks.at("swap").used_percent = mem.percent.at("swap_used").back();
-					disks.at("swap").free_percent = mem.percent.at("swap_free").back();
+					disks.at("swap").total = mem.stats[field::swap_total];
+					disks.at("swap").used = mem.stats[field::swap_used];
+					disks.at("swap").free = mem.stats[field::swap_free];
+					disks.at("swap").used_percent = mem.percent[field::swap_used].back();
+					disks.at("swap").free_percent = mem.percent[field::swap_free].back();
 				}
 				for (const auto& name : last_found)
 					#ifdef SNAPPED
@@ -1128,89 +1699,87 @@ namespace Mem {
 						if (not is_in(name, "/", "swap")) mem.disks_order.push_back(name);
 					#endif
 
+				//? Read counters for all block devices from /proc/diskstats in one pass, indexed by major:minor
+				static unordered_flat_map<uint64_t, array<int64_t, 11>> diskstats;
+				diskstats.clear();
+				if (rng::any_of(disks, [](const auto& disk) { return disk.second.devno != 0; })) {
+					auto content = Shared::proc_dir.read("diskstats");
+					while (not content.empty()) {
+						auto line = next_token(content, '\n');
+						const auto major = sv_to<unsigned>(next_token(line));
+						const auto minor = sv_to<unsigned>(next_token(line));
+						next_token(line); // skip device name
+						auto& fields = diskstats[makedev(major, minor)];
+						for (auto& field : fields) field = sv_to<int64_t>(next_token(line));
+					}
+				}
+
 				//? Get disks IO
-				int64_t sectors_read, sectors_write, io_ticks, io_ticks_temp;
+				int64_t sectors_read, sectors_write, io_ticks;
 				disk_ios = 0;
 				for (auto& [ignored, disk] : disks) {
-					if (disk.stat.empty() or access(disk.stat.c_str(), R_OK) != 0) continue;
-					if (disk.fstype == "zfs" && zfs_hide_datasets && zfs_collect_pool_total_stats(disk)) {
-						disk_ios++;
+					const array<int64_t, 11>* dev_fields = nullptr;
+					if (disk.devno != 0) {
+						auto entry = diskstats.find(disk.devno);
+						if (entry == diskstats.end()) continue;
+						dev_fields = &entry->second;
+					}
+					//? ZFS Pool Support
+					else if (disk.fstype == "zfs") {
+						if (disk.stat.empty()) continue;
+						if (zfs_collect_stats(disk, zfs_hide_datasets)) disk_ios++;
+						else Logger::debug("Error in Mem::collect() : when reading ZFS stats from " + disk.stat.string());
 						continue;
 					}
-					diskread.open(disk.stat);
-					if (diskread.good()) {
+					else if (disk.stat.empty() or access(disk.stat.c_str(), R_OK) != 0) continue;
+					std::string_view stat;
+					if (dev_fields == nullptr) stat = Shared::proc_dir.read(disk.stat.c_str());
+					if (dev_fields != nullptr or not stat.empty()) {
 						disk_ios++;
-						//? ZFS Pool Support
-						if (disk.fstype == "zfs") {
-							// skip first three lines
-							for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> io_ticks;
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> sectors_write; // nbytes written
-							if (disk.io_write.empty())
-								disk.io_write.push_back(0);
-							else
-								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1))));
-							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> io_ticks_temp;
-							io_ticks += io_ticks_temp;
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> sectors_read; // nbytes read
-							if (disk.io_read.empty())
-								disk.io_read.push_back(0);
-							else
-								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0))));
-							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
-
-							if (disk.io_activity.empty())
-								disk.io_activity.push_back(0);
-							else
-								disk.io_activity.push_back(max((int64_t)0, (io_ticks - disk.old_io.at(2))));
-							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
-						} else {
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_read;
-							if (disk.io_read.empty())
-								disk.io_read.push_back(0);
-							else
-								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
-							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
-
-							for (int i = 0; i < 3; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_write;
-							if (disk.io_write.empty())
-								disk.io_write.push_back(0);
-							else
-								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
-							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
-
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> io_ticks;
-							if (disk.io_activity.empty())
-								disk.io_activity.push_back(0);
-							else
-								disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
-							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+						//? Fields: 0 = reads, 2 = sectors read, 3 = ms reading, 4 = writes, 6 = sectors written, 7 = ms writing,
+						//? 9 = io ticks, 10 = weighted ms in queue, same layout in /proc/diskstats and /sys/block stat files
+						array<int64_t, 11> fields{};
+						if (dev_fields != nullptr) fields = *dev_fields;
+						else for (auto& field : fields) field = sv_to<int64_t>(next_token(stat));
+						sectors_read = fields[2];
+						if (disk.io_read.empty())
+							disk.io_read.push_back(0);
+						else
+							disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
+						disk.old_io.at(0) = sectors_read;
+						while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+
+						sectors_write = fields[6];
+						if (disk.io_write.empty())
+							disk.io_write.push_back(0);
+						else
+							disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
+						disk.old_io.at(1) = sectors_write;
+						while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+
+						io_ticks = fields[9];
+						if (disk.io_activity.empty())
+							disk.io_activity.push_back(0);
+						else
+							disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
+						disk.old_io.at(2) = io_ticks;
+						while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+
+						//? Operations per second, average time per operation (await) and average queue depth (aqu-sz)
+						const array<int64_t, 4> ops = {fields[0], fields[4], fields[3] + fields[7], fields[10]};
+						if (disk.has_ops and uptime > old_uptime) {
+							const double elapsed = uptime - old_uptime;
+							const auto reads = max((int64_t)0, ops[0] - disk.old_ops[0]), writes = max((int64_t)0, ops[1] - disk.old_ops[1]);
+							disk.ops_read = reads / elapsed;
+							disk.ops_write = writes / elapsed;
+							disk.await = (reads + writes > 0 ? (double)max((int64_t)0, ops[2] - disk.old_ops[2]) / (reads + writes) : 0.0);
+							disk.queue = max((int64_t)0, ops[3] - disk.old_ops[3]) / (elapsed * 1000);
 						}
+						disk.old_ops = ops;
+						disk.has_ops = true;
 					} else {
 						Logger::debug("Error in Mem::collect() : when opening " + string{disk.stat});
 					}
-					diskread.close();
 				}
 				old_uptime = uptime;
 			}
@@ -1234,98 +1803,24 @@ namespace Mem {
 			}
 		}
 
-		ifstream filestream;
-		string filename;
-		string name_compare;
-
 		if (dataset_name_start != std::string::npos) { // device is a dataset
 			zfs_pool_stat_path = Shared::procPath / "spl/kstat/zfs" / device_name.substr(0, dataset_name_start);
 		} else { // device is a pool
 			zfs_pool_stat_path = Shared::procPath / "spl/kstat/zfs" / device_name;
 		}
 
-		// looking through all files that start with 'objset' to find the one containing `device_name` object stats
-		for (const auto& file: fs::directory_iterator(zfs_pool_stat_path)) {
-			filename = file.path().filename();
-			if (filename.starts_with("objset")) {
-				filestream.open(file.path());
-				if (filestream.good()) {
-					// skip first two lines
-					for (int i = 0; i < 2; i++) filestream.ignore(numeric_limits<streamsize>::max(), '\n');
-					// skip characters until '7' is reached, indicating data type 7, next value will be object name
-					filestream.ignore(numeric_limits<streamsize>::max(), '7');
-					filestream >> name_compare;
-					if (name_compare == device_name) {
-						filestream.close();
-						if (access(file.path().c_str(), R_OK) == 0) {
-							return file.path();
-						} else {
-							Logger::debug("Can't access file: " + file.path().string());
-							return "";
-						}
-					}
-				}
-				filestream.close();
-			}
-		}
-
-		Logger::debug("Could not read directory: " + zfs_pool_stat_path.string());
-		return "";
+		//? Find the objset file containing `device_name` object stats
+		auto path = zfs_kstats.find(zfs_pool_stat_path.string(), device_name);
+		if (path.empty()) Logger::debug("Could not find objset for " + device_name + " in " + zfs_pool_stat_path.string());
+		return path;
 	}
 
-	bool zfs_collect_pool_total_stats(struct disk_info &disk) {
-		ifstream diskread;
-
-		int64_t bytes_read;
-		int64_t bytes_write;
-		int64_t io_ticks;
-		int64_t bytes_read_total{};     // defaults to 0
-		int64_t bytes_write_total{};    // defaults to 0
-		int64_t io_ticks_total{};       // defaults to 0
-		int64_t objects_read{};         // defaults to 0
-
-		// looking through all files that start with 'objset'
-		for (const auto& file: fs::directory_iterator(disk.stat)) {
-			if ((file.path().filename()).string().starts_with("objset")) {
-				diskread.open(file.path());
-				if (diskread.good()) {
-					try {
-						// skip first three lines
-						for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_write;
-						bytes_write_total += bytes_write;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_read;
-						bytes_read_total += bytes_read;
-					} catch (const std::exception& e) {
-						continue;
-					}
-
-					// increment read objects counter if no errors were encountered
-					objects_read++;
-				} else {
-					Logger::debug("Could not read file: " + file.path().string());
-				}
-				diskread.close();
-			}
-		}
-
-		// if for some reason no objects were read
-		if (objects_read == 0) return false;
+	bool zfs_collect_stats(struct disk_info &disk, bool pool_total) {
+		ZfsKstats::counters stats;
+		if (not (pool_total ? zfs_kstats.totals(disk.stat.string(), stats) : zfs_kstats.single(disk.stat, stats))) return false;
+		const int64_t io_ticks_total = stats.reads + stats.writes;
+		const int64_t bytes_read_total = stats.nread;
+		const int64_t bytes_write_total = stats.nwritten;
 
 		if (disk.io_write.empty())
 			disk.io_write.push_back(0);
@@ -1344,7 +1839,8 @@ namespace Mem {
 		if (disk.io_activity.empty())
 			disk.io_activity.push_back(0);
 		else
-			disk.io_activity.push_back(max((int64_t)0, (io_ticks_total - disk.old_io.at(2))));
+			//? ZFS kstats have no busy time, operations since last update are used as activity and capped to the 8 bit percentage history
+			disk.io_activity.push_back(clamp(io_ticks_total - disk.old_io.at(2), (int64_t)0, (int64_t)100));
 		disk.old_io.at(2) = io_ticks_total;
 		while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
 
@@ -1359,142 +1855,831 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors{}; // defaults to 0
-	unordered_flat_map<string, uint64_t> graph_max = { {"download", {}}, {"upload", {}} };
-	unordered_flat_map<string, array<int, 2>> max_count = { {"download", {}}, {"upload", {}} };
+	per_direction<uint64_t> graph_max;
+	per_direction<array<int, 2>> max_count;
+	per_direction<uint64_t> packet_max;
+	per_direction<array<int, 2>> packet_count;
 	bool rescale{true};
 	uint64_t timestamp{}; // defaults to 0
 
-	//* RAII wrapper for getifaddrs
-	class getifaddr_wrapper {
-		struct ifaddrs* ifaddr;
-	public:
-		int status;
-		getifaddr_wrapper() { status = getifaddrs(&ifaddr); }
-		~getifaddr_wrapper() { freeifaddrs(ifaddr); }
-		auto operator()() -> struct ifaddrs* { return ifaddr; }
+	//* Counters, state and addresses of one interface, ipv4 holds the link layer address if the interface has no ip
+	struct link_info {
+		string name;
+		string ipv4;
+		string ipv6;
+		uint64_t rx_bytes{};    // defaults to 0
+		uint64_t tx_bytes{};    // defaults to 0
+		uint64_t rx_packets{};  // defaults to 0
+		uint64_t tx_packets{};  // defaults to 0
+		uint64_t rx_errors{};   // defaults to 0
+		uint64_t tx_errors{};   // defaults to 0
+		uint64_t rx_dropped{};  // defaults to 0
+		uint64_t tx_dropped{};  // defaults to 0
+		bool connected{};       // defaults to false
 	};
 
-	auto collect(bool no_update) -> net_info& {
-		if (Runner::stopping) return empty_net;
-		auto& net = current_net;
-		auto& config_iface = Config::getS("net_iface");
-		auto net_sync = Config::getB("net_sync");
-		auto net_auto = Config::getB("net_auto");
-		auto new_timestamp = time_ms();
-
-		if (not no_update and errors < 3) {
-			//? Get interface list using getifaddrs() wrapper
-			getifaddr_wrapper if_wrap {};
-			if (if_wrap.status != 0) {
-				errors++;
-				Logger::error("Net::collect() -> getifaddrs() failed with id " + to_string(if_wrap.status));
-				redraw = true;
-				return empty_net;
-			}
-			int family = 0;
-			static_assert(INET6_ADDRSTRLEN >= INET_ADDRSTRLEN); // 46 >= 16, compile-time assurance.
-			enum { IPBUFFER_MAXSIZE = INET6_ADDRSTRLEN }; // manually using the known biggest value, guarded by the above static_assert
-			char ip[IPBUFFER_MAXSIZE];
-			interfaces.clear();
-			string ipv4, ipv6;
-
-			//? Iteration over all items in getifaddrs() list
-			for (auto* ifa = if_wrap(); ifa != nullptr; ifa = ifa->ifa_next) {
-				if (ifa->ifa_addr == nullptr) continue;
-				family = ifa->ifa_addr->sa_family;
-				const auto& iface = ifa->ifa_name;
-
-				//? Update available interfaces vector and get status of interface
-				if (not v_contains(interfaces, iface)) {
-					interfaces.push_back(iface);
-					net[iface].connected = (ifa->ifa_flags & IFF_RUNNING);
-
-					// An interface can have more than one IP of the same family associated with it,
-					// but we pick only the first one to show in the NET box.
-					// Note: Interfaces without any IPv4 and IPv6 set are still valid and monitorable!
-					net[iface].ipv4.clear();
-					net[iface].ipv6.clear();
-				}
-
-
-				//? Get IPv4 address
-				if (family == AF_INET) {
-					if (net[iface].ipv4.empty()) {
-						if (nullptr != inet_ntop(family, &(reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)->sin_addr), ip, IPBUFFER_MAXSIZE)) {
-							net[iface].ipv4 = ip;
-						} else {
-							int errsv = errno;
-							Logger::error("Net::collect() -> Failed to convert IPv4 to string for iface " + string(iface) + ", errno: " + strerror(errsv));
-						}
-					}
+	//* Reads all interface counters with a single RTM_GETLINK dump over NETLINK_ROUTE instead of sysfs reads per interface.
+	//* Addresses are dumped once and only dumped again after RTM_NEWADDR/RTM_DELADDR notifications on a multicast socket
+	class RtNetlink {
+		int query_fd = -1;
+		int event_fd = -1;
+		uint32_t seq{};         // defaults to 0
+		bool addr_dirty{true};
+		vector<char> buffer = vector<char>(65536);
+
+		//? First IPv4 and IPv6 address of each interface index from the last address dump
+		unordered_flat_map<int, array<string, 2>> addresses;
+
+		//* Send a dump request of <type> and call <fn> with each reply message, returns false on errors
+		template <typename F>
+		bool dump(uint16_t type, F fn) {
+			struct {
+				nlmsghdr nlh;
+				rtgenmsg gen;
+			} req{};
+			req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(rtgenmsg));
+			req.nlh.nlmsg_type = type;
+			req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+			req.nlh.nlmsg_seq = ++seq;
+			req.gen.rtgen_family = AF_UNSPEC;
+			if (send(query_fd, &req, req.nlh.nlmsg_len, 0) != (ssize_t)req.nlh.nlmsg_len) return false;
+
+			for (;;) {
+				const ssize_t len = recv(query_fd, buffer.data(), buffer.size(), 0);
+				if (len < 0 and errno == EINTR) continue;
+				if (len <= 0) return false;
+				int remaining = len;
+				for (auto* nlh = reinterpret_cast<const nlmsghdr*>(buffer.data()); NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+					if (nlh->nlmsg_seq != seq) continue;
+					if (nlh->nlmsg_type == NLMSG_DONE) return true;
+					if (nlh->nlmsg_type == NLMSG_ERROR) return false;
+					fn(nlh);
 				}
-				//? Get IPv6 address
-				else if (family == AF_INET6) {
-					if (net[iface].ipv6.empty()) {
-						if (nullptr != inet_ntop(family, &(reinterpret_cast<struct sockaddr_in6*>(ifa->ifa_addr)->sin6_addr), ip, IPBUFFER_MAXSIZE)) {
-							net[iface].ipv6 = ip;
-						} else {
-							int errsv = errno;
-							Logger::error("Net::collect() -> Failed to convert IPv6 to string for iface " + string(iface) + ", errno: " + strerror(errsv));
-						}
-					}
-				} //else, ignoring family==AF_PACKET (see man 3 getifaddrs) which is the first one in the `for` loop.
 			}
+		}
+
+		//* Call <fn> with type and payload of each attribute in <rta> of length <len>
+		template <typename F>
+		static void for_each_attr(const rtattr* rta, int len, F fn) {
+			for (; RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+				fn(rta->rta_type, RTA_DATA(rta), RTA_PAYLOAD(rta));
+		}
 
-			//? Get total recieved and transmitted bytes + device address if no ip was found
-			for (const auto& iface : interfaces) {
-				if (net.at(iface).ipv4.empty() and net.at(iface).ipv6.empty())
-					net.at(iface).ipv4 = readfile("/sys/class/net/" + iface + "/address");
+		//* Drain address notifications, returns true if any address was added or removed or notifications were lost
+		bool addresses_changed() {
+			bool changed{};     // defaults to false
+			for (;;) {
+				const ssize_t len = recv(event_fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+				if (len < 0 and errno == EINTR) continue;
+				if (len < 0 and errno == ENOBUFS) {
+					changed = true;
+					continue;
+				}
+				if (len <= 0) break;
+				int remaining = len;
+				for (auto* nlh = reinterpret_cast<const nlmsghdr*>(buffer.data()); NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining))
+					if (nlh->nlmsg_type == RTM_NEWADDR or nlh->nlmsg_type == RTM_DELADDR) changed = true;
+			}
+			return changed;
+		}
 
-				for (const string dir : {"download", "upload"}) {
-					const fs::path sys_file = "/sys/class/net/" + iface + "/statistics/" + (dir == "download" ? "rx_bytes" : "tx_bytes");
-					auto& saved_stat = net.at(iface).stat.at(dir);
-					auto& bandwidth = net.at(iface).bandwidth.at(dir);
+		bool read_addresses() {
+			static_assert(INET6_ADDRSTRLEN >= INET_ADDRSTRLEN);
+			char ip[INET6_ADDRSTRLEN];
+			addresses.clear();
+			return dump(RTM_GETADDR, [&](const nlmsghdr* nlh) {
+				if (nlh->nlmsg_type != RTM_NEWADDR) return;
+				const auto* ifa = static_cast<const ifaddrmsg*>(NLMSG_DATA(nlh));
+				if (ifa->ifa_family != AF_INET and ifa->ifa_family != AF_INET6) return;
+				auto& ip_str = addresses[ifa->ifa_index][ifa->ifa_family == AF_INET ? 0 : 1];
+				if (not ip_str.empty()) return;
+				//? Like getifaddrs(), IPv4 uses the local address if set, it differs from IFA_ADDRESS on point-to-point links
+				const void* addr = nullptr;
+				for_each_attr(IFA_RTA(ifa), IFA_PAYLOAD(nlh), [&](int type, const void* data, size_t) {
+					if (type == IFA_LOCAL or (type == IFA_ADDRESS and addr == nullptr)) addr = data;
+				});
+				if (addr == nullptr) return;
+				if (inet_ntop(ifa->ifa_family, addr, ip, sizeof(ip)) != nullptr) ip_str = ip;
+				else Logger::error("Net::collect() -> Failed to convert address to string for index " + to_string(ifa->ifa_index) + ", errno: " + strerror(errno));
+			});
+		}
 
-					uint64_t val{}; // defaults to 0
-					try { val = (uint64_t)stoull(readfile(sys_file, "0")); }
-					catch (const std::invalid_argument&) {}
-					catch (const std::out_of_range&) {}
+	public:
+		RtNetlink() {
+			query_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+			if (query_fd < 0) {
+				Logger::debug("Net: could not open NETLINK_ROUTE socket, using getifaddrs: " + string{strerror(errno)});
+				return;
+			}
+			event_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+			sockaddr_nl addr{};
+			addr.nl_family = AF_NETLINK;
+			addr.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+			if (event_fd >= 0 and bind(event_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+				close(event_fd);
+				event_fd = -1;
+			}
+			if (event_fd < 0) Logger::debug("Net: no address notifications, addresses are read every update");
+		}
+		RtNetlink(const RtNetlink&) = delete;
+		RtNetlink& operator=(const RtNetlink&) = delete;
+		~RtNetlink() {
+			if (query_fd >= 0) close(query_fd);
+			if (event_fd >= 0) close(event_fd);
+		}
 
-					//? Update speed, total and top values
-					if (val < saved_stat.last) {
-						saved_stat.rollover += saved_stat.last;
-						saved_stat.last = 0;
+		bool active() const { return query_fd >= 0; }
+
+		//* Fill <links> with all interfaces, returns false if the dump failed
+		bool read(vector<link_info>& links) {
+			if (event_fd < 0 or addresses_changed()) addr_dirty = true;
+			if (addr_dirty and read_addresses()) addr_dirty = false;
+
+			links.clear();
+			return dump(RTM_GETLINK, [&](const nlmsghdr* nlh) {
+				if (nlh->nlmsg_type != RTM_NEWLINK) return;
+				const auto* ifi = static_cast<const ifinfomsg*>(NLMSG_DATA(nlh));
+				auto& link = links.emplace_back();
+				link.connected = (ifi->ifi_flags & IFF_RUNNING);
+				string mac;
+				for_each_attr(IFLA_RTA(ifi), IFLA_PAYLOAD(nlh), [&](int type, const void* data, size_t len) {
+					if (type == IFLA_IFNAME)
+						link.name = static_cast<const char*>(data);
+					else if (type == IFLA_STATS64 and len >= offsetof(rtnl_link_stats64, multicast)) {
+						//? Newer headers can have more fields than the running kernel sends
+						rtnl_link_stats64 stats{};
+						std::memcpy(&stats, data, min(len, sizeof(stats)));
+						link.rx_bytes = stats.rx_bytes;
+						link.tx_bytes = stats.tx_bytes;
+						link.rx_packets = stats.rx_packets;
+						link.tx_packets = stats.tx_packets;
+						link.rx_errors = stats.rx_errors;
+						link.tx_errors = stats.tx_errors;
+						link.rx_dropped = stats.rx_dropped;
+						link.tx_dropped = stats.tx_dropped;
 					}
-					if (cmp_greater((unsigned long long)saved_stat.rollover + (unsigned long long)val, numeric_limits<uint64_t>::max())) {
-						saved_stat.rollover = 0;
-						saved_stat.last = 0;
+					else if (type == IFLA_ADDRESS) {
+						const auto* bytes = static_cast<const uint8_t*>(data);
+						for (size_t i = 0; i < len; i++) mac += fmt::format("{}{:02x}", (i > 0 ? ":" : ""), bytes[i]);
 					}
-					saved_stat.speed = round((double)(val - saved_stat.last) / ((double)(new_timestamp - timestamp) / 1000));
-					if (saved_stat.speed > saved_stat.top) saved_stat.top = saved_stat.speed;
-					if (saved_stat.offset > val + saved_stat.rollover) saved_stat.offset = 0;
-					saved_stat.total = (val + saved_stat.rollover) - saved_stat.offset;
-					saved_stat.last = val;
-
-					//? Add values to graph
-					bandwidth.push_back(saved_stat.speed);
-					while (cmp_greater(bandwidth.size(), width * 2)) bandwidth.pop_front();
-
-					//? Set counters for auto scaling
-					if (net_auto and selected_iface == iface) {
-						if (net_sync and saved_stat.speed < net.at(iface).stat.at(dir == "download" ? "upload" : "download").speed) continue;
-						if (saved_stat.speed > graph_max[dir]) {
-							++max_count[dir][0];
-							if (max_count[dir][1] > 0) --max_count[dir][1];
-						}
-						else if (graph_max[dir] > 10 << 10 and saved_stat.speed < graph_max[dir] / 10) {
-							++max_count[dir][1];
-							if (max_count[dir][0] > 0) --max_count[dir][0];
+				});
+				if (link.name.empty()) {
+					links.pop_back();
+					return;
+				}
+				if (auto addr = addresses.find(ifi->ifi_index); addr != addresses.end()) {
+					link.ipv4 = addr->second[0];
+					link.ipv6 = addr->second[1];
+				}
+				if (link.ipv4.empty() and link.ipv6.empty()) link.ipv4 = std::move(mac);
+			});
+		}
+	};
+
+	RtNetlink rtnetlink;
+
+	//* RAII wrapper for getifaddrs
+	class getifaddr_wrapper {
+		struct ifaddrs* ifaddr;
+	public:
+		int status;
+		getifaddr_wrapper() { status = getifaddrs(&ifaddr); }
+		~getifaddr_wrapper() { freeifaddrs(ifaddr); }
+		auto operator()() -> struct ifaddrs* { return ifaddr; }
+	};
+
+	//* Lists TCP sockets with their tcp_info through NETLINK_SOCK_DIAG. Rates are computed against the counters from the previous
+	//* dump keyed by socket cookie, and only the connections that are kept get their addresses formatted and owners looked up
+	class TcpDiag {
+	public:
+		struct sample {
+			uint64_t rx_rate{};     // defaults to 0
+			uint64_t tx_rate{};     // defaults to 0
+			uint64_t inode{};       // defaults to 0
+			array<uint32_t, 4> src{}, dst{};
+			uint32_t rtt{};         // defaults to 0
+			uint32_t retrans{};     // defaults to 0
+			uint16_t sport{};       // defaults to 0
+			uint16_t dport{};       // defaults to 0
+			uint8_t family{};       // defaults to 0
+		};
+
+	private:
+		struct previous {
+			uint64_t acked{};       // defaults to 0
+			uint64_t received{};    // defaults to 0
+			uint64_t generation{};  // defaults to 0
+		};
+
+		//? All states except listening and time wait, sockets in those have no transfer counters
+		static constexpr uint32_t states = 0xfff & ~((1u << 10) | (1u << 6));
+		static constexpr uint64_t owner_scan_ms = 5'000;
+		int fd = -1;
+		uint32_t seq{};             // defaults to 0
+		uint64_t generation{};      // defaults to 0
+		uint64_t last_dump{};       // defaults to 0
+		unordered_flat_map<uint64_t, previous> prev;
+		vector<sample> samples;
+		vector<char> buffer = vector<char>(1 << 18);
+		unordered_flat_map<uint64_t, size_t> inode_pid;
+		uint64_t owners_scanned{};  // defaults to 0
+
+		//* Dump TCP sockets of <family> and add a sample with rates over <elapsed> seconds for each
+		bool dump(uint8_t family, double elapsed) {
+			struct {
+				nlmsghdr nlh;
+				inet_diag_req_v2 req;
+			} request{};
+			request.nlh.nlmsg_len = sizeof(request);
+			request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+			request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+			request.nlh.nlmsg_seq = ++seq;
+			request.req.sdiag_family = family;
+			request.req.sdiag_protocol = IPPROTO_TCP;
+			request.req.idiag_states = states;
+			request.req.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+			if (send(fd, &request, sizeof(request), 0) != (ssize_t)sizeof(request)) return false;
+
+			for (;;) {
+				const ssize_t len = recv(fd, buffer.data(), buffer.size(), 0);
+				if (len < 0 and errno == EINTR) continue;
+				if (len <= 0) return false;
+				int remaining = len;
+				for (auto* nlh = reinterpret_cast<const nlmsghdr*>(buffer.data()); NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+					if (nlh->nlmsg_seq != seq) continue;
+					if (nlh->nlmsg_type == NLMSG_DONE) return true;
+					if (nlh->nlmsg_type == NLMSG_ERROR) return false;
+					if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY) continue;
+
+					const auto* msg = static_cast<const inet_diag_msg*>(NLMSG_DATA(nlh));
+					tcp_info info{};
+					bool has_info{};    // defaults to false
+					int attr_len = nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*msg));
+					for (auto* rta = reinterpret_cast<const rtattr*>(msg + 1); RTA_OK(rta, attr_len); rta = RTA_NEXT(rta, attr_len)) {
+						if (rta->rta_type != INET_DIAG_INFO) continue;
+						//? Older kernels send a shorter tcp_info, missing fields stay 0
+						std::memcpy(&info, RTA_DATA(rta), min((size_t)RTA_PAYLOAD(rta), sizeof(info)));
+						has_info = true;
+					}
+					if (not has_info) continue;
+
+					uint64_t cookie;
+					std::memcpy(&cookie, msg->id.idiag_cookie, sizeof(cookie));
+					auto& old = prev[cookie];
+					auto& s = samples.emplace_back();
+					const uint64_t acked = info.tcpi_bytes_acked, received = info.tcpi_bytes_received;
+					if (old.generation != 0 and elapsed > 0) {
+						s.rx_rate = round((double)(received - min(old.received, received)) / elapsed);
+						s.tx_rate = round((double)(acked - min(old.acked, acked)) / elapsed);
+					}
+					old = {acked, received, generation};
+					s.inode = msg->idiag_inode;
+					std::memcpy(s.src.data(), msg->id.idiag_src, sizeof(s.src));
+					std::memcpy(s.dst.data(), msg->id.idiag_dst, sizeof(s.dst));
+					s.sport = ntohs(msg->id.idiag_sport);
+					s.dport = ntohs(msg->id.idiag_dport);
+					s.rtt = info.tcpi_rtt;
+					s.retrans = info.tcpi_total_retrans;
+					s.family = msg->idiag_family;
+				}
+			}
+		}
+
+	public:
+		//* Format <addr> of <family> with <port> as ip:port, ipv6 addresses are put in brackets
+		static string address(uint8_t family, const array<uint32_t, 4>& addr, uint16_t port) {
+			char ip[INET6_ADDRSTRLEN];
+			if (inet_ntop(family, addr.data(), ip, sizeof(ip)) == nullptr) return "";
+			return (family == AF_INET6 ? fmt::format("[{}]:{}", ip, port) : fmt::format("{}:{}", ip, port));
+		}
+
+		TcpDiag() = default;
+		TcpDiag(const TcpDiag&) = delete;
+		TcpDiag& operator=(const TcpDiag&) = delete;
+		~TcpDiag() { stop(); }
+
+		//* Close the socket and forget previous counters
+		void stop() {
+			if (fd >= 0) close(fd);
+			fd = -1;
+			prev = {};
+			samples = {};
+			inode_pid = {};
+			last_dump = 0;
+		}
+
+		//* Dump all TCP sockets and compute rates since the last dump, returns false if the sockets couldn't be dumped
+		bool update() {
+			if (fd < 0) {
+				fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+				if (fd < 0) {
+					Logger::debug("Net: could not open NETLINK_SOCK_DIAG socket: " + string{strerror(errno)});
+					return false;
+				}
+			}
+			const uint64_t now = time_ms();
+			const double elapsed = (last_dump > 0 ? (now - last_dump) / 1000.0 : 0.0);
+			last_dump = now;
+			generation++;
+			samples.clear();
+			if (not dump(AF_INET, elapsed) or not dump(AF_INET6, elapsed)) {
+				Logger::debug("Net: NETLINK_SOCK_DIAG dump failed");
+				stop();
+				return false;
+			}
+
+			//? Forget sockets that are gone
+			for (auto it = prev.begin(); it != prev.end();) {
+				if (it->second.generation != generation) it = prev.erase(it);
+				else it++;
+			}
+			return true;
+		}
+
+		//? Sockets from the last update()
+		vector<sample>& sockets() { return samples; }
+
+		//* True if owners should be scanned again, when a socket in [<first>, <last>) is unknown and the last scan is old enough
+		bool owners_stale(auto first, auto last) const {
+			return time_ms() - owners_scanned > owner_scan_ms
+				and std::any_of(first, last, [&](const sample& s) { return s.inode != 0 and not inode_pid.contains(s.inode); });
+		}
+
+		//* Map socket inodes to pids by reading the fd links of processes in <pids>
+		void scan_owners(const auto& pids) {
+			inode_pid.clear();
+			owners_scanned = time_ms();
+			char link[64];
+			for (const size_t pid : pids) {
+				const string fd_dir = fmt::format("{}/{}/fd", Shared::procPath.string(), pid);
+				DIR* dir = opendir(fd_dir.c_str());
+				if (dir == nullptr) continue;
+				while (const auto* entry = readdir(dir)) {
+					if (entry->d_type != DT_LNK) continue;
+					const ssize_t len = readlinkat(dirfd(dir), entry->d_name, link, sizeof(link) - 1);
+					if (len <= 9 or std::string_view(link, 8) != "socket:[") continue;
+					inode_pid.try_emplace(sv_to<uint64_t>(std::string_view(link + 8, len - 8)), pid);
+				}
+				closedir(dir);
+			}
+		}
+
+		//* Pid owning socket <inode>, 0 if not known
+		size_t owner(uint64_t inode) const {
+			const auto found = inode_pid.find(inode);
+			return (found != inode_pid.end() ? found->second : 0);
+		}
+	};
+
+	//* Dumps TCP sockets on a helper thread for both the connection list of the net box and the per process rates of the proc
+	//* box, so dumping sockets and reading the fd links of all processes to find their owners never runs on the update tick.
+	//* The helper keeps one TcpDiag and owner map for both and runs at the shortest interval asked for by either
+	class TcpMonitor {
+	public:
+		enum class user { connections, processes };
+
+	private:
+		//? Shared with the detached helper, which keeps its own reference
+		struct shared_state {
+			std::mutex mtx;
+			std::condition_variable cv;
+			unordered_flat_map<size_t, array<uint64_t, 2>> rates; // pid -> {rx, tx} bytes per second
+			vector<connection_info> connections;
+			size_t total{};         // defaults to 0
+			bool fresh{};           // connections not taken yet, defaults to false
+			array<uint64_t, 2> intervals{}; // milliseconds asked for by each user, 0 if not used
+			bool running{};         // defaults to false
+			bool stop{};            // defaults to false
+		};
+
+		static constexpr size_t max_connections = 100;
+		std::shared_ptr<shared_state> state = std::make_shared<shared_state>();
+
+		static void helper_loop(std::shared_ptr<shared_state> st) {
+			TcpDiag diag;
+			unordered_flat_map<size_t, array<uint64_t, 2>> rates;
+			vector<connection_info> connections;
+			vector<size_t> pids;
+			std::unique_lock lock(st->mtx);
+			while (not st->stop) {
+				const bool want_connections = st->intervals[0] > 0, want_rates = st->intervals[1] > 0;
+				lock.unlock();
+				rates.clear();
+				connections.clear();
+				size_t total = 0;
+				if (diag.update()) {
+					auto& sockets = diag.sockets();
+					total = sockets.size();
+
+					//? The connection list keeps the sockets with the highest throughput, the rates only need sockets moving data
+					const size_t kept = (want_connections ? min(max_connections, sockets.size()) : 0);
+					rng::partial_sort(sockets, sockets.begin() + kept, [](const auto& a, const auto& b) { return a.rx_rate + a.tx_rate > b.rx_rate + b.tx_rate; });
+					const auto active_end = std::partition(sockets.begin() + kept, sockets.end(), [](const auto& s) { return s.rx_rate + s.tx_rate > 0; });
+					const auto owned_end = (want_rates ? active_end : sockets.begin() + kept);
+
+					//? The fd links of all processes are read again if a socket that needs an owner is unknown
+					if (diag.owners_stale(sockets.begin(), owned_end)) {
+						pids.clear();
+						std::error_code ec;
+						for (const auto& d : fs::directory_iterator(Shared::procPath, ec))
+							if (const auto pid = sv_to<size_t>(d.path().filename().native()); pid > 0) pids.push_back(pid);
+						diag.scan_owners(pids);
+					}
+
+					if (want_rates) {
+						for (auto it = sockets.begin(); it != active_end; ++it) {
+							if (it->rx_rate + it->tx_rate == 0) continue;
+							if (const auto pid = diag.owner(it->inode); pid > 0) {
+								auto& rate = rates[pid];
+								rate[0] += it->rx_rate;
+								rate[1] += it->tx_rate;
+							}
 						}
+					}
+
+					connections.resize(kept);
+					for (size_t i = 0; i < kept; i++) {
+						const auto& s = sockets[i];
+						auto& conn = connections[i];
+						conn.local = TcpDiag::address(s.family, s.src, s.sport);
+						conn.remote = TcpDiag::address(s.family, s.dst, s.dport);
+						conn.rx_rate = s.rx_rate;
+						conn.tx_rate = s.tx_rate;
+						conn.rtt = s.rtt;
+						conn.retrans = s.retrans;
+						conn.pid = diag.owner(s.inode);
+					}
+				}
+				lock.lock();
+				st->rates.swap(rates);
+				st->connections.swap(connections);
+				st->total = total;
+				st->fresh = true;
+				const auto interval = (st->intervals[0] > 0 and st->intervals[1] > 0 ? min(st->intervals[0], st->intervals[1]) : max(st->intervals[0], st->intervals[1]));
+				st->cv.wait_for(lock, std::chrono::milliseconds(interval), [&] { return st->stop; });
+			}
+			st->running = false;
+		}
+
+	public:
+		TcpMonitor() = default;
+		TcpMonitor(const TcpMonitor&) = delete;
+		TcpMonitor& operator=(const TcpMonitor&) = delete;
+		~TcpMonitor() {
+			stop(user::connections);
+			stop(user::processes);
+		}
+
+		//* Start the helper if not running, <interval> is the time between socket dumps in milliseconds wanted by <who>
+		void start(user who, uint64_t interval) {
+			auto old = state;
+			std::lock_guard lock(old->mtx);
+			if (old->running and not old->stop) {
+				old->intervals[(size_t)who] = interval;
+				return;
+			}
+			//? A helper still winding down keeps the old state, the new one starts clean
+			if (old->stop) state = std::make_shared<shared_state>();
+			state->intervals[(size_t)who] = interval;
+			state->running = true;
+			std::thread(helper_loop, state).detach();
+		}
+
+		//* Stop collecting for <who>, the helper is stopped when neither user is left
+		void stop(user who) {
+			{
+				std::lock_guard lock(state->mtx);
+				if (not state->running) return;
+				state->intervals[(size_t)who] = 0;
+				if (who == user::connections) state->connections.clear();
+				else state->rates.clear();
+				if (state->intervals[0] > 0 or state->intervals[1] > 0) return;
+				state->stop = true;
+			}
+			state->cv.notify_all();
+		}
+
+		//* Move the connections from the latest dump into <out> and the number of sockets found into <total>
+		//* Returns false and leaves <out> unchanged if they were already taken
+		bool take_connections(vector<connection_info>& out, size_t& total) {
+			std::lock_guard lock(state->mtx);
+			if (not state->fresh) return false;
+			out.swap(state->connections);
+			total = state->total;
+			state->fresh = false;
+			return true;
+		}
+
+		//* Set net_rx and net_tx of <procs> from the latest rates
+		void apply(vector<Proc::proc_info>& procs) {
+			std::lock_guard lock(state->mtx);
+			for (auto& p : procs) {
+				const auto rate = state->rates.find(p.pid);
+				p.net_rx = (rate != state->rates.end() ? rate->second[0] : 0);
+				p.net_tx = (rate != state->rates.end() ? rate->second[1] : 0);
+			}
+		}
+	};
+
+	TcpMonitor tcp_monitor;
+	vector<connection_info> connections;
+	size_t connection_count{};  // defaults to 0
+
+	//* Reads selected counters from /proc/net/snmp style files. The line and column of each counter are looked up in the header
+	//* lines on the first read and reused after that, they are only looked up again if a line doesn't start with the expected prefix
+	class ProtoCounters {
+		struct field {
+			string prefix;          // line prefix, like "Tcp:"
+			string line_start;      // prefix followed by a space, checked on every read
+			string name;            // counter name in the header line, or the key before the value for "key value" lines
+			size_t line = std::string_view::npos;
+			size_t column{};        // defaults to 0
+		};
+
+		const char* path;
+		bool header_lines;          // values are on the line after a header line with the same prefix, otherwise "key value" pairs
+		vector<field> fields;
+		vector<std::string_view> lines;
+		bool mapped{};              // defaults to false
+
+		void map() {
+			for (auto& f : fields) {
+				f.line = std::string_view::npos;
+				for (size_t i = 0; i < lines.size(); i++) {
+					auto line = lines[i];
+					if (next_token(line) != f.prefix) continue;
+					for (size_t col = 1; not line.empty(); col++) {
+						if (next_token(line) != f.name) continue;
+						if (not header_lines) f.line = i, f.column = col + 1;
+						else if (i + 1 < lines.size()) f.line = i + 1, f.column = col;
+						break;
+					}
+					//? The first line with the prefix is the header line
+					if (header_lines or f.line != std::string_view::npos) break;
+				}
+				if (f.line == std::string_view::npos) Logger::debug("Net: counter " + f.prefix + ' ' + f.name + " not found in " + path);
+			}
+			mapped = true;
+		}
+
+	public:
+		ProtoCounters(const char* path, bool header_lines, const vector<std::pair<string, string>>& wanted) : path(path), header_lines(header_lines) {
+			for (const auto& [prefix, name] : wanted) fields.push_back({prefix, prefix + ' ', name});
+		}
+
+		//* Read counters into <values> in the order they were given, counters that couldn't be found are 0
+		bool read(vector<int64_t>& values) {
+			auto content = Shared::proc_dir.read(path);
+			if (content.empty()) return false;
+			lines.clear();
+			while (not content.empty()) lines.push_back(next_token(content, '\n'));
+			const auto in_place = [&](const field& f) {
+				return f.line == std::string_view::npos or (f.line < lines.size() and lines[f.line].starts_with(f.line_start));
+			};
+			if (not mapped or not rng::all_of(fields, in_place)) map();
+
+			values.assign(fields.size(), 0);
+			for (size_t i = 0; i < fields.size(); i++) {
+				const auto& f = fields[i];
+				if (f.line == std::string_view::npos or not in_place(f)) continue;
+				auto line = lines[f.line];
+				std::string_view token;
+				for (size_t col = 0; col <= f.column; col++) token = next_token(line);
+				values[i] = sv_to<int64_t>(token);
+			}
+			return true;
+		}
+	};
+
+	ProtoCounters snmp{"net/snmp", true, {{"Tcp:", "RetransSegs"}, {"Tcp:", "OutRsts"}, {"Udp:", "RcvbufErrors"}}};
+	ProtoCounters netstat{"net/netstat", true, {{"TcpExt:", "ListenOverflows"}}};
+	ProtoCounters sockstat{"net/sockstat", false, {{"TCP:", "orphan"}, {"TCP:", "tw"}}};
+	enum_array<protocol, RingBuffer<long long>, protocol_names> protocols;
+
+	//* Add protocol counters to history, counters are converted to rates over <elapsed> milliseconds
+	void collect_protocols(uint64_t elapsed) {
+		static vector<int64_t> snmp_values, netstat_values, sockstat_values;
+		static array<int64_t, 4> last_counters{};
+		if (not snmp.read(snmp_values) or not netstat.read(netstat_values) or not sockstat.read(sockstat_values)) return;
+
+		static constexpr array rates = {protocol::retrans, protocol::resets, protocol::listen_overflows, protocol::udp_rcvbuf_errors};
+		const array<int64_t, 4> counters = {snmp_values[0], snmp_values[1], netstat_values[0], snmp_values[2]};
+		const bool first = protocols[protocol::retrans].empty();
+		for (size_t i = 0; i < rates.size(); i++) {
+			protocols[rates[i]].push_back(first or elapsed == 0 ? 0 : max((int64_t)0, (int64_t)round((counters[i] - last_counters[i]) * 1000.0 / elapsed)));
+		}
+		last_counters = counters;
+		protocols[protocol::orphans].push_back(sockstat_values[0]);
+		protocols[protocol::time_wait].push_back(sockstat_values[1]);
+		for (auto& history : protocols)
+			while (cmp_greater(history.size(), width * 2)) history.pop_front();
+	}
+
+	//* Fallback for when NETLINK_ROUTE isn't available, reads addresses with getifaddrs() and counters from sysfs
+	bool read_getifaddrs(vector<link_info>& links) {
+		//? Get interface list using getifaddrs() wrapper
+		getifaddr_wrapper if_wrap {};
+		if (if_wrap.status != 0) {
+			Logger::error("Net::collect() -> getifaddrs() failed with id " + to_string(if_wrap.status));
+			return false;
+		}
+		int family = 0;
+		static_assert(INET6_ADDRSTRLEN >= INET_ADDRSTRLEN); // 46 >= 16, compile-time assurance.
+		enum { IPBUFFER_MAXSIZE = INET6_ADDRSTRLEN }; // manually using the known biggest value, guarded by the above static_assert
+		char ip[IPBUFFER_MAXSIZE];
+		unordered_flat_map<string, size_t> index;
+		links.clear();
+
+		//? Iteration over all items in getifaddrs() list
+		for (auto* ifa = if_wrap(); ifa != nullptr; ifa = ifa->ifa_next) {
+			if (ifa->ifa_addr == nullptr) continue;
+			family = ifa->ifa_addr->sa_family;
+			const auto& iface = ifa->ifa_name;
+
+			//? Add interface and get status of interface
+			auto [pos, added] = index.try_emplace(iface, links.size());
+			if (added) {
+				links.emplace_back();
+				links.back().name = iface;
+				links.back().connected = (ifa->ifa_flags & IFF_RUNNING);
+			}
+			auto& link = links[pos->second];
+
+			// An interface can have more than one IP of the same family associated with it,
+			// but we pick only the first one to show in the NET box.
+			// Note: Interfaces without any IPv4 and IPv6 set are still valid and monitorable!
+
+			//? Get IPv4 address
+			if (family == AF_INET) {
+				if (link.ipv4.empty()) {
+					if (nullptr != inet_ntop(family, &(reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)->sin_addr), ip, IPBUFFER_MAXSIZE)) {
+						link.ipv4 = ip;
+					} else {
+						int errsv = errno;
+						Logger::error("Net::collect() -> Failed to convert IPv4 to string for iface " + string(iface) + ", errno: " + strerror(errsv));
+					}
+				}
+			}
+			//? Get IPv6 address
+			else if (family == AF_INET6) {
+				if (link.ipv6.empty()) {
+					if (nullptr != inet_ntop(family, &(reinterpret_cast<struct sockaddr_in6*>(ifa->ifa_addr)->sin6_addr), ip, IPBUFFER_MAXSIZE)) {
+						link.ipv6 = ip;
+					} else {
+						int errsv = errno;
+						Logger::error("Net::collect() -> Failed to convert IPv6 to string for iface " + string(iface) + ", errno: " + strerror(errsv));
+					}
+				}
+			} //else, ignoring family==AF_PACKET (see man 3 getifaddrs) which is the first one in the `for` loop.
+		}
+
+		//? Get total recieved and transmitted bytes + device address if no ip was found
+		for (auto& link : links) {
+			if (link.ipv4.empty() and link.ipv6.empty())
+				link.ipv4 = readfile("/sys/class/net/" + link.name + "/address");
+			const string stat_dir = "/sys/class/net/" + link.name + "/statistics/";
+			const array<std::pair<const char*, uint64_t*>, 8> counters = {{
+				{"rx_bytes", &link.rx_bytes}, {"tx_bytes", &link.tx_bytes}, {"rx_packets", &link.rx_packets}, {"tx_packets", &link.tx_packets},
+				{"rx_errors", &link.rx_errors}, {"tx_errors", &link.tx_errors}, {"rx_dropped", &link.rx_dropped}, {"tx_dropped", &link.tx_dropped}
+			}};
+			for (const auto& [file, value] : counters)
+				*value = sv_to<uint64_t>(Shared::proc_dir.read((stat_dir + file).c_str()));
+		}
+		return true;
+	}
+
+	//* Update <saved_stat> with counter value <val> read <elapsed> milliseconds after the last and add the rate to <history>
+	void update_stat(net_stat& saved_stat, RingBuffer<long long>& history, uint64_t val, uint64_t elapsed) {
+		//? Update speed, total and top values
+		if (val < saved_stat.last) {
+			saved_stat.rollover += saved_stat.last;
+			saved_stat.last = 0;
+		}
+		if (cmp_greater((unsigned long long)saved_stat.rollover + (unsigned long long)val, numeric_limits<uint64_t>::max())) {
+			saved_stat.rollover = 0;
+			saved_stat.last = 0;
+		}
+		saved_stat.speed = round((double)(val - saved_stat.last) / ((double)elapsed / 1000));
+		if (saved_stat.speed > saved_stat.top) saved_stat.top = saved_stat.speed;
+		if (saved_stat.offset > val + saved_stat.rollover) saved_stat.offset = 0;
+		saved_stat.total = (val + saved_stat.rollover) - saved_stat.offset;
+		saved_stat.last = val;
+
+		//? Add values to graph
+		history.push_back(saved_stat.speed);
+		while (cmp_greater(history.size(), width * 2)) history.pop_front();
+	}
+
+	//* Count updates where the rate of <dir> was above <maxes> or far below it, <floor> is the lowest scale
+	void count_scale(per_direction<uint64_t>& maxes, per_direction<array<int, 2>>& counts,
+					 direction dir, const per_direction<net_stat>& stats, bool sync, uint64_t floor) {
+		const auto speed = stats[dir].speed;
+		if (sync and speed < stats[dir == direction::download ? direction::upload : direction::download].speed) return;
+		if (speed > maxes[dir]) {
+			++counts[dir][0];
+			if (counts[dir][1] > 0) --counts[dir][1];
+		}
+		else if (maxes[dir] > floor and speed < maxes[dir] / 10) {
+			++counts[dir][1];
+			if (counts[dir][0] > 0) --counts[dir][0];
+		}
+	}
 
+	//* Set new <maxes> from the average of the last rates in <history> if rescaling or after 5 counted updates
+	void scale_max(per_direction<uint64_t>& maxes, per_direction<array<int, 2>>& counts,
+				   const per_direction<RingBuffer<long long>>& history, const per_direction<net_stat>& stats, bool sync_max, uint64_t floor) {
+		bool sync = false;
+		for (const auto dir : directions) {
+			for (const auto& sel : {0, 1}) {
+				if (rescale or counts[dir][sel] >= 5) {
+					const long long avg_speed = (history[dir].size() > 5
+						? std::accumulate(history[dir].rbegin(), history[dir].rbegin() + 5, 0ll) / 5
+						: stats[dir].speed);
+					maxes[dir] = max(uint64_t(avg_speed * (sel == 0 ? 1.3 : 3.0)), floor);
+					counts[dir][0] = counts[dir][1] = 0;
+					redraw = true;
+					if (sync_max) sync = true;
+					break;
+				}
+			}
+			//? Sync download/upload graphs if enabled
+			if (sync) {
+				const auto other = (dir == direction::upload ? direction::download : direction::upload);
+				maxes[other] = maxes[dir];
+				counts[other][0] = counts[other][1] = 0;
+				break;
+			}
+		}
+	}
+
+	auto collect(bool no_update) -> net_info& {
+		if (Runner::stopping) return empty_net;
+		auto& net = current_net;
+		auto& config_iface = Config::getS("net_iface");
+		auto net_sync = Config::getB("net_sync");
+		auto net_auto = Config::getB("net_auto");
+		auto new_timestamp = time_ms();
+
+		if (not no_update and errors < 3) {
+			static vector<link_info> links;
+			if (not (rtnetlink.active() ? rtnetlink.read(links) : read_getifaddrs(links))) {
+				errors++;
+				if (rtnetlink.active()) Logger::error("Net::collect() -> RTM_GETLINK dump failed");
+				redraw = true;
+				return empty_net;
+			}
+			interfaces.clear();
+
+			//? TCP connections sorted by throughput, dumped by the tcp helper and only the names of their owners looked up here
+			if (Config::getB("net_connections")) {
+				tcp_monitor.start(TcpMonitor::user::connections, Config::getI("update_ms"));
+				if (tcp_monitor.take_connections(connections, connection_count)) {
+					for (auto& conn : connections) {
+						if (const auto p = (conn.pid != 0 ? Proc::find_proc(conn.pid) : nullptr); p != nullptr) conn.name = p->name.str();
+					}
+				}
+			}
+			else {
+				tcp_monitor.stop(TcpMonitor::user::connections);
+				connections.clear();
+				connection_count = 0;
+			}
+
+			//? Protocol counters
+			if (Config::getB("net_protocols")) collect_protocols(new_timestamp - timestamp);
+			else if (not protocols[protocol::retrans].empty()) protocols = {};
+
+			for (auto& link : links) {
+				const auto& iface = link.name;
+				interfaces.push_back(iface);
+				auto& info = net[iface];
+				info.connected = link.connected;
+				info.ipv4 = std::move(link.ipv4);
+				info.ipv6 = std::move(link.ipv6);
+
+				for (const auto dir : directions) {
+					const bool rx = (dir == direction::download);
+					update_stat(info.stat[dir], info.bandwidth[dir], (rx ? link.rx_bytes : link.tx_bytes), new_timestamp - timestamp);
+
+					//? Packets, errors and drops per second
+					update_stat(info.packet_stat[dir], info.packets[dir], (rx ? link.rx_packets : link.tx_packets), new_timestamp - timestamp);
+					update_stat(info.error_stat[dir], info.errors[dir], (rx ? link.rx_errors : link.tx_errors), new_timestamp - timestamp);
+					update_stat(info.drop_stat[dir], info.drops[dir], (rx ? link.rx_dropped : link.tx_dropped), new_timestamp - timestamp);
+
+					//? Set counters for auto scaling, packet graphs are always auto scaled
+					if (selected_iface == iface) {
+						if (net_auto) count_scale(graph_max, max_count, dir, info.stat, net_sync, 10 << 10);
+						count_scale(packet_max, packet_count, dir, info.packet_stat, net_sync, 10);
 					}
 				}
 			}
 
 			//? Clean up net map if needed
 			if (net.size() > interfaces.size()) {
+				unordered_flat_map<std::string_view, bool> current;
+				for (const auto& iface : interfaces) current[iface] = true;
 				for (auto it = net.begin(); it != net.end();) {
-					if (not v_contains(interfaces, it->first))
+					if (not current.contains(it->first))
 						it = net.erase(it);
 					else
 						it++;
@@ -1510,17 +2695,18 @@ namespace Net {
 			return empty_net;
 
 		//? Find an interface to display if selected isn't set or valid
-		if (selected_iface.empty() or not v_contains(interfaces, selected_iface)) {
-			max_count["download"][0] = max_count["download"][1] = max_count["upload"][0] = max_count["upload"][1] = 0;
+		if (selected_iface.empty() or not net.contains(selected_iface)) {
+			max_count = {};
+			packet_count = {};
 			redraw = true;
-			if (net_auto) rescale = true;
-			if (not config_iface.empty() and v_contains(interfaces, config_iface)) selected_iface = config_iface;
+			rescale = true;
+			if (not config_iface.empty() and net.contains(config_iface)) selected_iface = config_iface;
 			else {
 				//? Sort interfaces by total upload + download bytes
 				auto sorted_interfaces = interfaces;
 				rng::sort(sorted_interfaces, [&](const auto& a, const auto& b){
-					return 	cmp_greater(net.at(a).stat["download"].total + net.at(a).stat["upload"].total,
-										net.at(b).stat["download"].total + net.at(b).stat["upload"].total);
+					return 	cmp_greater(net.at(a).stat[direction::download].total + net.at(a).stat[direction::upload].total,
+										net.at(b).stat[direction::download].total + net.at(b).stat[direction::upload].total);
 				});
 				selected_iface.clear();
 				//? Try to set to a connected interface
@@ -1536,30 +2722,9 @@ namespace Net {
 		}
 
 		//? Calculate max scale for graphs if needed
-		if (net_auto) {
-			bool sync = false;
-			for (const auto& dir: {"download", "upload"}) {
-				for (const auto& sel : {0, 1}) {
-					if (rescale or max_count[dir][sel] >= 5) {
-						const long long avg_speed = (net[selected_iface].bandwidth[dir].size() > 5
-							? std::accumulate(net.at(selected_iface).bandwidth.at(dir).rbegin(), net.at(selected_iface).bandwidth.at(dir).rbegin() + 5, 0ll) / 5
-							: net[selected_iface].stat[dir].speed);
-						graph_max[dir] = max(uint64_t(avg_speed * (sel == 0 ? 1.3 : 3.0)), (uint64_t)10 << 10);
-						max_count[dir][0] = max_count[dir][1] = 0;
-						redraw = true;
-						if (net_sync) sync = true;
-						break;
-					}
-				}
-				//? Sync download/upload graphs if enabled
-				if (sync) {
-					const auto other = (string(dir) == "upload" ? "download" : "upload");
-					graph_max[other] = graph_max[dir];
-					max_count[other][0] = max_count[other][1] = 0;
-					break;
-				}
-			}
-		}
+		auto& selected = net.at(selected_iface);
+		if (net_auto) scale_max(graph_max, max_count, selected.bandwidth, selected.stat, net_sync, 10 << 10);
+		scale_max(packet_max, packet_count, selected.packets, selected.packet_stat, net_sync, 10);
 
 		rescale = false;
 		return net.at(selected_iface);
@@ -1569,26 +2734,492 @@ namespace Net {
 namespace Proc {
 
 	vector<proc_info> current_procs;
-	unordered_flat_map<string, string> uid_user;
 	string current_sort;
 	string current_filter;
 	bool current_rev{}; // defaults to false
 
-	fs::file_time_type passwd_time;
-
 	uint64_t cputimes;
 	int collapse = -1, expand = -1;
 	uint64_t old_cputimes{};    // defaults to 0
 	atomic<int> numpids{};      // defaults to 0
+	atomic<int> pids_read{};    // defaults to 0
 	int filter_found{};         // defaults to 0
 
 	detail_container detailed;
 	constexpr size_t KTHREADD = 2;
 	static robin_hood::unordered_set<size_t> kernels_procs = {KTHREADD};
 
+	//* Position of a pid in current_procs, the collection generation it was last seen in and refresh state
+	struct pid_slot {
+		size_t index{};     // defaults to 0
+		uint64_t seen{};    // defaults to 0
+		uint64_t hot{};     // refreshed every update up to and including this generation, defaults to 0
+		uint64_t cputimes{};// total cpu times when last read, defaults to 0
+		size_t tree_parent{};   // defaults to 0
+		bool in_tree{};         // defaults to false
+		uint32_t prefix_key{};  // depth and flags the tree prefix was last generated for, defaults to 0
+		uint64_t stale_until{}; // time_ms() until which reads that timed out aren't retried, defaults to 0
+		uint8_t backoff{};      // reads timed out in a row, defaults to 0
+		bool cmd_stale{};       // cmdline read timed out and is retried after stale_until, defaults to false
+		bool summed{};          // values of collapsed children were added in the last tree generation, defaults to false
+	};
+
+	//? Index of pid -> pid_slot kept in sync with current_procs
+	unordered_flat_map<size_t, pid_slot> pid_index;
+	uint64_t generation{}; // defaults to 0
+
+	//* Refresh positions in pid_index after current_procs has been reordered
+	void _update_index() {
+		for (size_t i = 0; auto& p : current_procs) {
+			pid_index.at(p.pid).index = i++;
+		}
+	}
+
+	//? Persistent process tree, pid -> pids of children in current_procs, root processes are stored as children of 0
+	unordered_flat_map<size_t, vector<size_t>> tree_children;
+
+	//* Remove <pid> from the children of its parent in the process tree
+	void _tree_unlink(const size_t pid, pid_slot& slot) {
+		if (not slot.in_tree) return;
+		auto siblings = tree_children.find(slot.tree_parent);
+		if (siblings != tree_children.end()) {
+			auto& vec = siblings->second;
+			if (auto it = rng::find(vec, pid); it != vec.end()) vec.erase(it);
+			if (vec.empty()) tree_children.erase(siblings);
+		}
+		slot.in_tree = false;
+	}
+
+	//* Add <pid> to the children of <parent> in the process tree if not already there
+	void _tree_link(const size_t pid, pid_slot& slot, const size_t parent) {
+		if (slot.in_tree) {
+			if (slot.tree_parent == parent) return;
+			_tree_unlink(pid, slot);
+		}
+		tree_children[parent].push_back(pid);
+		slot.tree_parent = parent;
+		slot.in_tree = true;
+	}
+
+	//* Options for the current tree generation
+	struct tree_gen_opts {
+		const filter_matcher& filter;
+		const string& sorting;
+		bool reverse;
+		bool no_update;
+		size_t tree_index{};  // next free tree index, defaults to 0
+		bool by_field{};      // order siblings by the sorted field instead of position in current_procs, defaults to false
+	};
+
+	//* Return the proc_info of <pid> in current_procs
+	inline proc_info& _tree_proc(const size_t pid) {
+		return current_procs[pid_index.at(pid).index];
+	}
+
+	const proc_info* find_proc(const size_t pid) {
+		const auto slot = pid_index.find(pid);
+		if (slot == pid_index.end() or slot->second.index >= current_procs.size()) return nullptr;
+		const auto& proc = current_procs[slot->second.index];
+		return (proc.pid == pid ? &proc : nullptr);
+	}
+
+	//* Add values of <child> to its collapsed parent <proc>
+	inline void _tree_add(proc_info& proc, const proc_info& child) {
+		proc.cpu_p += child.cpu_p;
+		proc.cpu_c += child.cpu_c;
+		proc.mem += child.mem;
+		proc.threads += child.threads;
+		proc.net_rx += child.net_rx;
+		proc.net_tx += child.net_tx;
+	}
+
+	//* Remove values of <child> added by _tree_add() from <proc>
+	inline void _tree_sub(proc_info& proc, const proc_info& child) {
+		proc.cpu_p = max(0.0, proc.cpu_p - child.cpu_p);
+		proc.cpu_c = max(0.0, proc.cpu_c - child.cpu_c);
+		proc.mem -= min(proc.mem, child.mem);
+		proc.threads -= min(proc.threads, child.threads);
+		proc.net_rx -= min(proc.net_rx, child.net_rx);
+		proc.net_tx -= min(proc.net_tx, child.net_tx);
+	}
+
+	//* Try to find name of the binary file and append to program name if not the same
+	inline void _tree_short_cmd(proc_info& proc) {
+		if (not proc.short_cmd.empty() or proc.cmd.empty()) return;
+		std::string_view cmd_view = proc.cmd.str();
+		cmd_view = cmd_view.substr((size_t)0, std::min(cmd_view.find(' '), cmd_view.size()));
+		cmd_view = cmd_view.substr(std::min(cmd_view.find_last_of('/') + 1, cmd_view.size()));
+		proc.short_cmd = string{cmd_view};
+	}
+
+	//* Regenerate tree prefix of <p> if depth, children, collapsed state or position among siblings changed
+	void _tree_prefix(proc_info& p, const bool first, const bool last) {
+		const bool has_children = tree_children.contains(p.pid);
+		const uint32_t prefix_key = (p.depth << 5) | (has_children << 4) | (p.collapsed << 3) | (last << 2) | (first << 1) | 1;
+		auto& slot = pid_index.at(p.pid);
+		if (slot.prefix_key != prefix_key or p.prefix.empty()) {
+			slot.prefix_key = prefix_key;
+			p.prefix = " │ "s * p.depth + (has_children ? (p.collapsed ? "[+]─" : "[-]─") : (last ? " └─ " : (first ? " ┌─ " : " ├─ ")));
+		}
+	}
+
+	//* Set depth and filtered state for the subtree of <proc> and add values of hidden children to collapsed processes
+	void _tree_filter(proc_info& proc, size_t depth, bool hidden, bool found, tree_gen_opts& opts) {
+		const auto& filter = opts.filter;
+		bool filtering = false;
+
+		//? If filtering, include children of matching processes
+		if (not found) {
+			if (filter(proc)) {
+				found = true;
+				depth = 0;
+			}
+			else
+				filtering = true;
+		}
+
+		proc.depth = depth;
+		proc.filtered = hidden or filtering;
+
+		if (not proc.filtered) _tree_short_cmd(proc);
+
+		auto children = tree_children.find(proc.pid);
+		const bool collapse = hidden or proc.collapsed;
+
+		//? Processes holding sums of their children are read every update so the sums start from fresh values of their own
+		if (not opts.no_update) pid_index.at(proc.pid).summed = (children != tree_children.end() and collapse and not filtering);
+		if (children == tree_children.end()) return;
+
+		for (const auto child_pid : children->second) {
+			auto& child = _tree_proc(child_pid);
+			_tree_filter(child, depth + 1, collapse, found, opts);
+
+			//? Values of collapsed children are added to their parent, only done on new data to not add them twice
+			if (not opts.no_update and not filtering and collapse) _tree_add(proc, child);
+		}
+	}
+
+	//* Sort children of <parent>, set tree index and regenerate tree prefix if changed for all shown processes in the subtree
+	void _tree_order(const size_t parent, tree_gen_opts& opts) {
+		auto children = tree_children.find(parent);
+		if (children == tree_children.end()) return;
+
+		//? Processes are already sorted in current_procs, so sorting by position gives the selected order for siblings
+		vector<proc_info*> nodes;
+		nodes.reserve(children->second.size());
+		for (const auto child_pid : children->second) nodes.push_back(&_tree_proc(child_pid));
+		if (not opts.by_field) rng::sort(nodes);
+
+		//? Sort again after collapsed processes got values of their children added
+		//? Without a sorted current_procs all fields are compared, with ties ordered by pid as in proc_sorter()
+		if (nodes.size() > 1) {
+			const auto sorter = [&](auto proj) {
+				if (opts.by_field) {
+					rng::sort(nodes, [&](const proc_info* a, const proc_info* b) {
+						const auto& a_val = proj(a);
+						const auto& b_val = proj(b);
+						if (a_val != b_val) return (opts.reverse ? a_val < b_val : a_val > b_val);
+						return a->pid < b->pid;
+					});
+				}
+				else if (opts.reverse) rng::stable_sort(nodes, rng::less{}, proj);
+				else rng::stable_sort(nodes, rng::greater{}, proj);
+			};
+			switch (v_index(sort_vector, opts.sorting)) {
+				case 0: if (opts.by_field) sorter([](const proc_info* p) { return p->pid; }); break;
+				case 1: if (opts.by_field) sorter([](const proc_info* p) -> const string& { return p->name.str(); }); break;
+				case 2: if (opts.by_field) sorter([](const proc_info* p) -> const string& { return p->cmd.str(); }); break;
+				case 3: sorter([](const proc_info* p) { return p->threads; }); break;
+				case 4: if (opts.by_field) sorter([](const proc_info* p) -> const string& { return p->user.str(); }); break;
+				case 5: sorter([](const proc_info* p) { return p->mem; }); break;
+				case 6: sorter([](const proc_info* p) { return p->cpu_p; }); break;
+				case 7: sorter([](const proc_info* p) { return p->cpu_c; }); break;
+				case 8: sorter([](const proc_info* p) { return p->net_rx + p->net_tx; }); break;
+			}
+		}
+
+		//? Store the order to make sorting faster next update
+		for (size_t i = 0; const auto* node : nodes) children->second[i++] = node->pid;
+
+		const auto first_it = rng::find(nodes, false, &proc_info::filtered);
+		const auto last_it = rng::find(nodes | std::views::reverse, false, &proc_info::filtered);
+		const proc_info* first_shown = (first_it != nodes.end() ? *first_it : nullptr);
+		const proc_info* last_shown = (last_it != rng::rend(nodes) ? *last_it : nullptr);
+		for (auto* node : nodes) {
+			auto& p = *node;
+			if (not p.filtered) {
+				p.tree_index = opts.tree_index++;
+				_tree_prefix(p, parent == 0 and node == first_shown, node == last_shown);
+			}
+
+			//? Subtrees of collapsed processes are hidden
+			if (not p.collapsed) _tree_order(p.pid, opts);
+		}
+	}
+
+	//* Hide the shown subtree of <proc> when collapsing it and add the values of its children, returns the number of processes hidden
+	//* Processes already holding the sums of their children keep them, only collapsed processes not holding sums are walked further
+	size_t _tree_hide(proc_info& proc, const size_t hidden_index) {
+		auto children = tree_children.find(proc.pid);
+		if (children == tree_children.end()) return 0;
+		auto& summed = pid_index.at(proc.pid).summed;
+		size_t count = 0;
+		for (const auto child_pid : children->second) {
+			auto& child = _tree_proc(child_pid);
+			if (not child.filtered) {
+				child.filtered = true;
+				child.tree_index = hidden_index;
+				count++;
+			}
+			if (not child.collapsed or not pid_index.at(child_pid).summed) count += _tree_hide(child, hidden_index);
+			if (not summed) _tree_add(proc, child);
+		}
+		summed = true;
+		return count;
+	}
+
+	//* Show the subtree of <proc> down to collapsed processes when expanding it and remove the values added from its children
+	//* Pids of the processes shown are added to <shown>
+	void _tree_show(proc_info& proc, vector<size_t>& shown) {
+		auto children = tree_children.find(proc.pid);
+		if (children == tree_children.end()) return;
+		auto& summed = pid_index.at(proc.pid).summed;
+		for (const auto child_pid : children->second) {
+			auto& child = _tree_proc(child_pid);
+			if (summed) _tree_sub(proc, child);
+			child.filtered = false;
+			_tree_short_cmd(child);
+			shown.push_back(child_pid);
+			if (not child.collapsed) _tree_show(child, shown);
+		}
+		summed = false;
+	}
+
+	//* Number of rows shown for the subtree of <pid>
+	size_t _tree_rows(const size_t pid) {
+		const auto& p = _tree_proc(pid);
+		size_t rows = not p.filtered;
+		if (auto children = tree_children.find(pid); not p.collapsed and children != tree_children.end()) {
+			for (const auto child_pid : children->second) rows += _tree_rows(child_pid);
+		}
+		return rows;
+	}
+
+	//* Set positions in pid_index and tree index of shown processes for rows <first> to <last> in current_procs
+	void _tree_reindex(const size_t first, const size_t last) {
+		for (size_t i = first; i < last; i++) {
+			auto& p = current_procs[i];
+			pid_index.at(p.pid).index = i;
+			if (not p.filtered) p.tree_index = i;
+		}
+	}
+
+	//* Move the rows of shown process <pid> among its siblings after sums of its children were added or removed and update their prefixes
+	//* Rows are only moved when sorted by a summed value, the siblings keep the order of the last tree generation otherwise
+	void _tree_resort(const size_t pid, const tree_gen_opts& opts) {
+		const int sort_index = v_index(sort_vector, opts.sorting);
+		const auto key = [sort_index](const proc_info& p) -> double {
+			switch (sort_index) {
+				case 3: return p.threads;
+				case 5: return p.mem;
+				case 6: return p.cpu_p;
+				case 7: return p.cpu_c;
+				case 8: return p.net_rx + p.net_tx;
+				default: return 0.0;
+			}
+		};
+		const auto before = [&](const proc_info& a, const proc_info& b) {
+			const double a_val = key(a), b_val = key(b);
+			if (a_val != b_val) return (opts.reverse ? a_val < b_val : a_val > b_val);
+			return a.pid < b.pid;
+		};
+
+		const auto& slot = pid_index.at(pid);
+		auto& siblings = tree_children.at(slot.tree_parent);
+		if (is_in(sort_index, 3, 5, 6, 7, 8)) {
+			const auto& proc = _tree_proc(pid);
+			const size_t pos = slot.index, rows = _tree_rows(pid);
+			const size_t old_i = rng::find(siblings, pid) - siblings.begin();
+			siblings.erase(siblings.begin() + old_i);
+			const size_t new_i = rng::find_if(siblings, [&](const size_t sibling) { return before(proc, _tree_proc(sibling)); }) - siblings.begin();
+			siblings.insert(siblings.begin() + new_i, pid);
+
+			//? Rotate the rows of the process past the rows of the siblings it moved over
+			const auto begin = current_procs.begin();
+			size_t first = pos, last = pos + rows;
+			if (new_i < old_i) {
+				for (size_t i = new_i + 1; i <= old_i; i++) first -= _tree_rows(siblings[i]);
+				std::rotate(begin + first, begin + pos, begin + last);
+			}
+			else if (new_i > old_i) {
+				for (size_t i = old_i; i < new_i; i++) last += _tree_rows(siblings[i]);
+				std::rotate(begin + pos, begin + pos + rows, begin + last);
+			}
+			_tree_reindex(first, last);
+		}
+
+		//? The first and last shown siblings get other prefixes
+		const auto first_it = rng::find(siblings, false, [](const size_t sibling) { return _tree_proc(sibling).filtered; });
+		const auto last_it = rng::find(siblings | std::views::reverse, false, [](const size_t sibling) { return _tree_proc(sibling).filtered; });
+		for (auto it = first_it; it != siblings.end(); ++it) {
+			auto& p = _tree_proc(*it);
+			if (not p.filtered) _tree_prefix(p, slot.tree_parent == 0 and it == first_it, *it == *last_it);
+		}
+	}
+
+	//* Collapse or expand <proc> in a tree generated by the last update, only its subtree and the rows below it are moved
+	//* Returns false if <proc> isn't shown and the tree needs to be generated again
+	bool _tree_toggle(proc_info& proc, const bool collapsed, tree_gen_opts& opts) {
+		const size_t pid = proc.pid, pos = pid_index.at(pid).index;
+		if (proc.filtered or proc.tree_index != pos) return false;
+		if (proc.collapsed == collapsed) return true;
+		proc.collapsed = collapsed;
+
+		const size_t shown = current_procs.size() - filter_found;
+		const auto begin = current_procs.begin();
+		if (collapsed) {
+			//? The shown subtree directly follows the process and is rotated to the start of the hidden processes
+			const size_t count = _tree_hide(proc, current_procs.size());
+			std::rotate(begin + pos + 1, begin + pos + 1 + count, begin + shown);
+			filter_found += count;
+			_tree_reindex(pos + 1, shown);
+		}
+		else {
+			static vector<size_t> shown_pids;
+			shown_pids.clear();
+			_tree_show(proc, shown_pids);
+			opts.tree_index = pos + 1;
+			opts.by_field = true;
+			_tree_order(pid, opts);
+
+			//? Gather the subtree in tree order at the start of the hidden processes and rotate it in after the process
+			static vector<size_t> tree_order;
+			tree_order.resize(shown_pids.size());
+			for (const auto shown_pid : shown_pids) tree_order[_tree_proc(shown_pid).tree_index - pos - 1] = shown_pid;
+			for (size_t i = shown; const auto shown_pid : tree_order) {
+				auto& from = pid_index.at(shown_pid).index;
+				if (from != i) {
+					std::swap(current_procs[from], current_procs[i]);
+					pid_index.at(current_procs[from].pid).index = from;
+					from = i;
+				}
+				i++;
+			}
+			std::rotate(begin + pos + 1, begin + shown, begin + shown + shown_pids.size());
+			filter_found -= shown_pids.size();
+			_tree_reindex(pos + 1, shown + shown_pids.size());
+		}
+
+		_tree_resort(pid, opts);
+		return true;
+	}
+
+	//* Path of <file> for process <pid> relative to /proc
+	class pid_file {
+		array<char, 48> path{};
+	public:
+		pid_file(const size_t pid, const std::string_view file) {
+			fmt::format_to_n(path.data(), path.size() - 1, "{}/{}", pid, file);
+		}
+		operator const char*() const { return path.data(); }
+	};
+
+	//* Reads files that take the mmap lock of a process (cmdline, smaps) on helper threads, so a process stuck in D state
+	//* or a page fault storm can't block the reading thread. A read that misses its deadline is abandoned and left to finish
+	//* in the background, when all helpers are stuck on abandoned reads new reads fail at once with Busy
+	class DeadlineReader {
+		struct request {
+			array<char, 48> path{};
+			size_t limit{};         // defaults to 0
+			string data{};          // defaults to ""
+			bool ok{};              // defaults to false
+			bool running{};         // defaults to false
+			bool done{};            // defaults to false
+			bool abandoned{};       // defaults to false
+		};
+
+		//? Shared with the detached helpers, which keep their own reference
+		struct helper_state {
+			std::mutex mtx;
+			std::condition_variable work_cv, done_cv;
+			deque<std::shared_ptr<request>> queue;
+			size_t helpers{}, idle{}, stuck{};
+		};
+
+		static constexpr size_t max_helpers = 4;
+		std::shared_ptr<helper_state> state = std::make_shared<helper_state>();
+
+		static void helper_loop(std::shared_ptr<helper_state> st) {
+			string data;
+			for (;;) {
+				std::shared_ptr<request> req;
+				{
+					std::unique_lock lck(st->mtx);
+					st->idle++;
+					st->work_cv.wait(lck, [&]{ return not st->queue.empty(); });
+					st->idle--;
+					req = std::move(st->queue.front());
+					st->queue.pop_front();
+					if (req->abandoned) continue;
+					req->running = true;
+				}
+				const bool ok = Shared::proc_dir.read(req->path.data(), data, req->limit);
+				{
+					std::lock_guard lck(st->mtx);
+					if (req->abandoned) st->stuck--;
+					req->ok = ok;
+					req->data.swap(data);
+					req->done = true;
+				}
+				st->done_cv.notify_all();
+			}
+		}
+	public:
+		enum class result { Ok, Failed, TimedOut, Busy };
+
+		//* Read <path> relative to /proc into <out>, waiting at most <deadline> for the read to finish
+		result read(const char* path, string& out, size_t limit, std::chrono::milliseconds deadline) {
+			auto req = std::make_shared<request>();
+			std::strncpy(req->path.data(), path, req->path.size() - 1);
+			req->limit = limit;
+
+			std::unique_lock lck(state->mtx);
+			if (state->stuck >= max_helpers) return result::Busy;
+			if (state->idle <= state->queue.size() and state->helpers < max_helpers) {
+				try {
+					std::thread(helper_loop, state).detach();
+					state->helpers++;
+				}
+				catch (const std::system_error&) {
+					if (state->helpers == 0) return result::Failed;
+				}
+			}
+			state->queue.push_back(req);
+			state->work_cv.notify_one();
+
+			if (not state->done_cv.wait_for(lck, deadline, [&]{ return req->done; })) {
+				req->abandoned = true;
+				if (req->running) state->stuck++;
+				return result::TimedOut;
+			}
+			out.swap(req->data);
+			return req->ok ? result::Ok : result::Failed;
+		}
+	};
+
+	DeadlineReader deadline_reader;
+
+	//? Deadlines for reads through deadline_reader, smaps can legitimately take a while for processes with many mappings
+	constexpr auto cmdline_deadline = 100ms;
+	constexpr auto smaps_deadline = 250ms;
+
+	//* Milliseconds to wait before retrying a process that timed out <backoff> times in a row, doubled for each timeout up to a minute
+	constexpr uint64_t stale_delay(const uint8_t backoff) {
+		return min((uint64_t)500 << min(backoff, (uint8_t)7), (uint64_t)60'000);
+	}
+
 	//* Get detailed info for selected process
 	void _collect_details(const size_t pid, const uint64_t uptime, vector<proc_info>& procs) {
-		fs::path pid_path = Shared::procPath / std::to_string(pid);
 
 		if (pid != detailed.last_pid) {
 			detailed = {};
@@ -1597,8 +3228,9 @@ namespace Proc {
 		}
 
 		//? Copy proc_info for process from proc vector
-		auto p_info = rng::find(procs, pid, &proc_info::pid);
-		detailed.entry = *p_info;
+		auto p_info = pid_index.find(pid);
+		if (p_info == pid_index.end()) return;
+		detailed.entry = procs.at(p_info->second.index);
 
 		//? Update cpu percent deque for process cpu graph
 		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
@@ -1611,29 +3243,33 @@ namespace Proc {
 
 		//? Get parent process name
 		if (detailed.parent.empty()) {
-			auto p_entry = rng::find(procs, detailed.entry.ppid, &proc_info::pid);
-			if (p_entry != procs.end()) detailed.parent = p_entry->name;
+			auto p_entry = pid_index.find(detailed.entry.ppid);
+			if (p_entry != pid_index.end()) detailed.parent = procs.at(p_entry->second.index).name;
 		}
 
 		//? Expand process status from single char to explanative string
 		detailed.status = (proc_states.contains(detailed.entry.state)) ? proc_states.at(detailed.entry.state) : "Unknown";
 
-		ifstream d_read;
-		string short_str;
-
-		//? Try to get RSS mem from proc/[pid]/smaps
+		//? Try to get RSS mem from proc/[pid]/smaps, skipped while the process is stale after a read timed out
 		detailed.memory.clear();
-		if (not detailed.skip_smaps and fs::exists(pid_path / "smaps")) {
-			d_read.open(pid_path / "smaps");
-			uint64_t rss = 0;
-			try {
-				while (d_read.good()) {
-					d_read.ignore(SSmax, 'R');
-					if (d_read.peek() == 's') {
-						d_read.ignore(SSmax, ':');
-						getline(d_read, short_str, 'k');
-						rss += stoull(short_str);
-					}
+		if (auto& slot = p_info->second; not detailed.skip_smaps and time_ms() >= slot.stale_until) {
+			static string smaps_buf;
+			const auto status = deadline_reader.read(pid_file(pid, "smaps"), smaps_buf, 0, smaps_deadline);
+			if (status == DeadlineReader::result::TimedOut) {
+				slot.stale_until = time_ms() + stale_delay(slot.backoff++);
+				Logger::debug("Reading smaps for pid " + to_string(pid) + " timed out, retrying in " + to_string(stale_delay(slot.backoff - 1)) + "ms.");
+			}
+			else if (status == DeadlineReader::result::Busy)
+				slot.stale_until = time_ms() + stale_delay(0);
+			else
+				slot.backoff = 0;
+			const std::string_view smaps = (status == DeadlineReader::result::Ok ? smaps_buf : std::string_view{});
+			if (not smaps.empty()) {
+				uint64_t rss = 0;
+				for (size_t pos = 0; (pos = smaps.find("\nRss:", pos)) != std::string_view::npos;) {
+					pos += 5;
+					auto value = smaps.substr(pos);
+					rss += sv_to<uint64_t>(next_token(value));
 				}
 				if (rss == detailed.entry.mem >> 10)
 					detailed.skip_smaps = true;
@@ -1642,9 +3278,6 @@ namespace Proc {
 					detailed.memory = floating_humanizer(rss, false, 1);
 				}
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
 		}
 		if (detailed.memory.empty()) {
 			detailed.mem_bytes.push_back(detailed.entry.mem);
@@ -1658,30 +3291,508 @@ namespace Proc {
 		while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
 
 		//? Get bytes read and written from proc/[pid]/io
-		if (fs::exists(pid_path / "io")) {
-			d_read.open(pid_path / "io");
-			try {
-				string name;
-				while (d_read.good()) {
-					getline(d_read, name, ':');
-					if (name.ends_with("read_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_read = floating_humanizer(stoull(short_str));
+		auto io = Shared::proc_dir.read(pid_file(pid, "io"));
+		while (not io.empty()) {
+			auto line = next_token(io, '\n');
+			const auto name = next_token(line, ':');
+			if (name == "read_bytes")
+				detailed.io_read = floating_humanizer(sv_to<uint64_t>(next_token(line)));
+			else if (name == "write_bytes") {
+				detailed.io_write = floating_humanizer(sv_to<uint64_t>(next_token(line)));
+				break;
+			}
+		}
+	}
+
+	//* Result of reading /proc/[pid] for a process, applied to current_procs after all pids have been read
+	struct proc_read {
+		enum : int { Failed, Partial, Done };
+		size_t index{};         // defaults to 0
+		bool no_cache{};        // defaults to false
+		bool got_uid{};         // defaults to false
+		bool read_cmd{};        // retry cmdline of a stale process, defaults to false
+		DeadlineReader::result cmd_status = DeadlineReader::result::Ok;
+		int status = Failed;
+		uint64_t cpu_t{};       // defaults to 0
+		uint32_t uid{};         // defaults to 0
+	};
+
+	//* Read comm, status and cmdline (if new or stale) and stat/statm for <new_proc>, only touches <new_proc> and <result>
+	void _read_proc(proc_info& new_proc, proc_read& result, const uint64_t totalMem, const int totalMem_len) {
+		const auto& pid = new_proc.pid;
+		result.status = proc_read::Failed;
+
+		//? Get program name and uid
+		if (result.no_cache) {
+			auto comm = Shared::proc_dir.read(pid_file(pid, "comm"));
+			if (comm.empty()) return;
+			if (comm.ends_with('\n')) comm.remove_suffix(1);
+			new_proc.name = comm;
+
+			auto status = Shared::proc_dir.read(pid_file(pid, "status"));
+			if (status.empty()) return;
+			if (const auto pos = status.find("\nUid:"); pos != std::string_view::npos) {
+				status.remove_prefix(pos + 5);
+				result.uid = sv_to<uint32_t>(next_token(status, '\t'));
+				result.got_uid = true;
+			}
+		}
+
+		//? Get command line, read with a deadline since it can block on the mmap lock, a stale command is retried later
+		if (result.no_cache or result.read_cmd) {
+			thread_local string cmd;
+			result.cmd_status = deadline_reader.read(pid_file(pid, "cmdline"), cmd, 1000, cmdline_deadline);
+			if (result.cmd_status == DeadlineReader::result::Failed) return;
+			if (result.cmd_status == DeadlineReader::result::Ok) {
+				while (cmd.ends_with('\0')) cmd.pop_back();
+				rng::replace(cmd, '\0', ' ');
+				new_proc.cmd = cmd;
+			}
+			else if (result.no_cache) new_proc.cmd = pooled_string{};
+		}
+
+		//? Parse /proc/[pid]/stat, fields are counted from after the last ')' to skip any whitespace in the process name
+		auto stat = Shared::proc_dir.read(pid_file(pid, "stat"));
+		const auto name_end = stat.rfind(')');
+		if (name_end == std::string_view::npos) return;
+		stat.remove_prefix(name_end + 1);
+
+		int field = 2;
+		uint64_t cpu_t = 0;
+		for (auto value = next_token(stat); not value.empty(); value = next_token(stat)) {
+			switch (++field) {
+				case 3: //? Process state
+					new_proc.state = value.front();
+					continue;
+				case 4: //? Parent pid
+					new_proc.ppid = sv_to<uint64_t>(value);
+					continue;
+				case 14: //? Process utime
+					cpu_t = sv_to<uint64_t>(value);
+					continue;
+				case 15: //? Process stime
+					cpu_t += sv_to<uint64_t>(value);
+					continue;
+				case 19: //? Nice value
+					new_proc.p_nice = sv_to<int64_t>(value);
+					continue;
+				case 20: //? Number of threads
+					new_proc.threads = sv_to<uint64_t>(value);
+					if (new_proc.cpu_s == 0) new_proc.cpu_t = cpu_t;
+					continue;
+				case 22: //? Get cpu seconds if missing
+					if (new_proc.cpu_s == 0) new_proc.cpu_s = sv_to<uint64_t>(value);
+					continue;
+				case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
+					if (cmp_greater(value.size(), totalMem_len))
+						new_proc.mem = totalMem;
+					else
+						new_proc.mem = sv_to<uint64_t>(value) * Shared::pageSize;
+					break;
+				default:
+					continue;
+			}
+			break;
+		}
+
+		result.status = proc_read::Partial;
+
+		if (field < 24) return;
+
+		//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
+		if (new_proc.mem >= totalMem) {
+			auto statm = Shared::proc_dir.read(pid_file(pid, "statm"));
+			if (statm.empty()) return;
+			next_token(statm);
+			new_proc.mem = sv_to<uint64_t>(next_token(statm)) * Shared::pageSize;
+		}
+
+		result.cpu_t = cpu_t;
+		result.status = proc_read::Done;
+	}
+
+	//* Persistent pool of worker threads, jobs are split in shards queued per worker and idle workers steal shards from the others
+	class ScanPool {
+		struct alignas(64) shard_queue {
+			atomic<size_t> next{};  // defaults to 0
+			size_t end{};           // defaults to 0
+		};
+
+		vector<std::thread> workers;
+		std::unique_ptr<shard_queue[]> queues;
+		std::mutex mtx;
+		std::condition_variable work_cv, done_cv;
+		std::function<void(size_t)> job;
+		size_t job_count{}, shard_size{}, busy{};
+		uint64_t batch{};   // defaults to 0
+		bool quit{};        // defaults to false
+
+		//* Run shards from own queue <q> and then steal from the other queues until all are empty
+		void work(size_t q) {
+			const size_t participants = workers.size() + 1;
+			for (size_t i = 0; i < participants; i++) {
+				auto& queue = queues[(q + i) % participants];
+				for (size_t shard; (shard = queue.next.fetch_add(1)) < queue.end;) {
+					const size_t last = min(job_count, (shard + 1) * shard_size);
+					//? Jobs handle their own errors, anything escaping is logged so a shard can't fail silently
+					for (size_t n = shard * shard_size; n < last; n++) {
+						try { job(n); }
+						catch (const std::exception& e) { Logger::debug("ScanPool::work() : job " + to_string(n) + " failed: " + string{e.what()}); }
+						catch (...) { Logger::debug("ScanPool::work() : job " + to_string(n) + " failed with an unknown exception"); }
 					}
-					else if (name.ends_with("write_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_write = floating_humanizer(stoull(short_str));
+				}
+			}
+		}
+
+		void worker_loop(size_t q) {
+			uint64_t last_batch = 0;
+			for (;;) {
+				{
+					std::unique_lock lck(mtx);
+					work_cv.wait(lck, [&]{ return quit or batch != last_batch; });
+					if (quit) return;
+					last_batch = batch;
+				}
+				work(q);
+				std::lock_guard lck(mtx);
+				if (--busy == 0) done_cv.notify_one();
+			}
+		}
+
+		void stop() {
+			{
+				std::lock_guard lck(mtx);
+				quit = true;
+			}
+			work_cv.notify_all();
+			for (auto& t : workers) t.join();
+			workers.clear();
+			quit = false;
+		}
+
+	public:
+		~ScanPool() { stop(); }
+
+		size_t size() const { return workers.size(); }
+
+		//* Set number of worker threads (calling thread participates as an additional worker)
+		void resize(size_t threads) {
+			if (threads == workers.size()) return;
+			stop();
+			queues = std::make_unique<shard_queue[]>(threads + 1);
+			for (size_t q = 1; q <= threads; q++) {
+				workers.emplace_back(&ScanPool::worker_loop, this, q);
+			}
+		}
+
+		//* Call <fn> for each index in 0 to <count> spread over all workers, returns when all are done
+		void run(size_t count, size_t shard, std::function<void(size_t)> fn) {
+			const size_t participants = workers.size() + 1;
+			const size_t shards = (count + shard - 1) / shard;
+			{
+				std::lock_guard lck(mtx);
+				job = std::move(fn);
+				job_count = count;
+				shard_size = shard;
+				for (size_t q = 0; q < participants; q++) {
+					queues[q].next = shards * q / participants;
+					queues[q].end = shards * (q + 1) / participants;
+				}
+				busy = workers.size();
+				batch++;
+			}
+			work_cv.notify_all();
+			work(0);
+			std::unique_lock lck(mtx);
+			done_cv.wait(lck, [&]{ return busy == 0; });
+			job = nullptr;
+		}
+	};
+
+	ScanPool scan_pool;
+
+	//* Subscriber to fork, exec and exit events from the kernel proc connector (NETLINK_CONNECTOR / CN_IDX_PROC)
+	class ProcEvents {
+		//? Event values from linux/cn_proc.h, the enum is scoped differently between kernel header versions
+		static constexpr uint32_t event_none = 0x00000000, event_fork = 0x00000001, event_exec = 0x00000002,
+								  event_uid = 0x00000004, event_comm = 0x00000200, event_exit = 0x80000000;
+		int fd = -1;
+		bool lost{};    // defaults to false
+
+		//* Call <fn> with each proc_event in netlink datagram <buf>
+		template <typename F>
+		static void for_each_event(char* buf, int len, F fn) {
+			for (auto* nlh = reinterpret_cast<nlmsghdr*>(buf); NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len)) {
+				if (nlh->nlmsg_type == NLMSG_ERROR or nlh->nlmsg_type == NLMSG_NOOP) continue;
+				const auto* msg = static_cast<const cn_msg*>(NLMSG_DATA(nlh));
+				if (msg->id.idx != CN_IDX_PROC or msg->id.val != CN_VAL_PROC) continue;
+				fn(*reinterpret_cast<const proc_event*>(msg->data));
+			}
+		}
+
+		bool send_op(proc_cn_mcast_op op) {
+			alignas(nlmsghdr) char buf[NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))]{};
+			auto* nlh = reinterpret_cast<nlmsghdr*>(buf);
+			nlh->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+			nlh->nlmsg_type = NLMSG_DONE;
+			auto* msg = static_cast<cn_msg*>(NLMSG_DATA(nlh));
+			msg->id.idx = CN_IDX_PROC;
+			msg->id.val = CN_VAL_PROC;
+			msg->len = sizeof(proc_cn_mcast_op);
+			std::memcpy(msg->data, &op, sizeof(op));
+			return send(fd, buf, nlh->nlmsg_len, 0) == (ssize_t)nlh->nlmsg_len;
+		}
+
+		//* Wait for the kernel to acknowledge the listen request, no ack or an error means we lack the privileges
+		bool wait_ack() {
+			alignas(nlmsghdr) char buf[4096];
+			const uint64_t deadline = time_ms() + 500;
+			for (uint64_t now = time_ms(); now < deadline; now = time_ms()) {
+				pollfd pfd = {fd, POLLIN, 0};
+				if (poll(&pfd, 1, deadline - now) <= 0) break;
+				const ssize_t len = recv(fd, buf, sizeof(buf), 0);
+				if (len <= 0) continue;
+				int ack = -1;
+				for_each_event(buf, len, [&ack](const proc_event& event) {
+					if (static_cast<uint32_t>(event.what) == event_none) ack = event.event_data.ack.err;
+				});
+				if (ack != -1) return ack == 0;
+			}
+			return false;
+		}
+
+	public:
+		enum : int { Fork, Exec };
+
+		//? Pids changed since last drain() and the last event type seen for each
+		unordered_flat_map<size_t, int> changes;
+
+		ProcEvents() = default;
+		ProcEvents(const ProcEvents&) = delete;
+		ProcEvents& operator=(const ProcEvents&) = delete;
+		~ProcEvents() { stop(); }
+
+		bool active() const { return fd >= 0; }
+
+		//* Subscribe to proc events, returns false if not supported or not permitted
+		bool start() {
+			if (fd >= 0) return true;
+			fd = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+			if (fd < 0) return false;
+
+			//? A larger receive buffer lowers the risk of dropped events during fork storms
+			const int rcvbuf = 1 << 20;
+			setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+			sockaddr_nl addr{};
+			addr.nl_family = AF_NETLINK;
+			addr.nl_groups = CN_IDX_PROC;
+			if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 or not send_op(PROC_CN_MCAST_LISTEN) or not wait_ack()) {
+				close(fd);
+				fd = -1;
+				return false;
+			}
+			changes.clear();
+			lost = true;
+			return true;
+		}
+
+		void stop() {
+			if (fd < 0) return;
+			send_op(PROC_CN_MCAST_IGNORE);
+			close(fd);
+			fd = -1;
+		}
+
+		//* Read all pending events into changes, returns false if events were lost since last call and a full rescan is needed
+		bool drain() {
+			alignas(nlmsghdr) static char buf[16384];
+			while (fd >= 0) {
+				const ssize_t len = recv(fd, buf, sizeof(buf), 0);
+				if (len < 0) {
+					if (errno == EINTR) continue;
+					else if (errno == ENOBUFS) {
+						lost = true;
+						continue;
+					}
+					else if (errno != EAGAIN and errno != EWOULDBLOCK) {
+						lost = true;
+						stop();
+					}
+					break;
+				}
+				for_each_event(buf, len, [this](const proc_event& event) {
+					switch (static_cast<uint32_t>(event.what)) {
+					case event_fork:
+						if (event.event_data.fork.child_pid == event.event_data.fork.child_tgid)
+							changes[event.event_data.fork.child_tgid] = Fork;
+						break;
+					case event_exec:
+						changes.try_emplace(event.event_data.exec.process_tgid, Exec);
+						break;
+					case event_uid:
+						if (event.event_data.id.process_pid == event.event_data.id.process_tgid)
+							changes.try_emplace(event.event_data.id.process_tgid, Exec);
+						break;
+					case event_comm:
+						if (event.event_data.comm.process_pid == event.event_data.comm.process_tgid)
+							changes.try_emplace(event.event_data.comm.process_tgid, Exec);
+						break;
+					//? The leader thread can exit while other threads keep the process alive, so an exit is only
+					//? a reason to read the process again, one that is really gone fails the read and is dropped
+					case event_exit:
+						if (event.event_data.exit.process_pid == event.event_data.exit.process_tgid)
+							changes.try_emplace(event.event_data.exit.process_tgid, Exec);
 						break;
 					}
-					else
-						d_read.ignore(SSmax, '\n');
+				});
+			}
+			return not std::exchange(lost, false);
+		}
+
+		//* Make next drain() report lost events
+		void invalidate() { lost = true; }
+	};
+
+	ProcEvents proc_events;
+
+	//* Cache of user names by uid, filled from /etc/passwd and by a background thread calling getpwuid() for uids
+	//* missing there, so a slow name service can't stall the runner. Uids are shown as numbers until resolved and
+	//* uids without a name are kept as numbers
+	class UidCache {
+		//? Shared with the detached resolver thread, which keeps its own reference
+		struct resolver_queue {
+			std::mutex mtx;
+			std::condition_variable cv;
+			vector<uint32_t> requests;
+			vector<std::pair<uint32_t, string>> results;
+		};
+
+		unordered_flat_map<uint32_t, pooled_string> names;
+		vector<uint32_t> pending;   // uids seen for the first time this update, handed to the resolver by flush()
+		std::shared_ptr<resolver_queue> resolver;
+		fs::file_time_type passwd_time;
+		uint64_t last_check{};  // defaults to 0
+
+		//? Takes all queued uids at once and returns their names in one batch
+		static void resolve_loop(std::shared_ptr<resolver_queue> queue) {
+			vector<char> buffer(16384);
+			vector<uint32_t> batch;
+			vector<std::pair<uint32_t, string>> resolved;
+			for (;;) {
+				{
+					std::unique_lock lck(queue->mtx);
+					queue->cv.wait(lck, [&]{ return not queue->requests.empty(); });
+					batch.swap(queue->requests);
+				}
+				for (const auto uid : batch) {
+					string name;
+				#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
+					struct passwd pwd, *result = nullptr;
+					while (getpwuid_r(uid, &pwd, buffer.data(), buffer.size(), &result) == ERANGE and buffer.size() < (1 << 20))
+						buffer.resize(buffer.size() * 2);
+					if (result != nullptr and result->pw_name != nullptr) name = result->pw_name;
+				#endif
+					resolved.emplace_back(uid, std::move(name));
 				}
+				batch.clear();
+				std::lock_guard lck(queue->mtx);
+				std::move(resolved.begin(), resolved.end(), std::back_inserter(queue->results));
+				resolved.clear();
+			}
+		}
+	public:
+		//* Hand uids seen for the first time this update to the resolver thread, which is started on first use
+		void flush() {
+		#if defined(STATIC_BUILD) && defined(__GLIBC__)
+			pending.clear();
+		#else
+			if (pending.empty()) return;
+			if (resolver == nullptr) {
+				try {
+					auto queue = std::make_shared<resolver_queue>();
+					std::thread(resolve_loop, queue).detach();
+					resolver = std::move(queue);
+				}
+				catch (const std::system_error&) {
+					pending.clear();
+					return;
+				}
+			}
+			{
+				std::lock_guard lck(resolver->mtx);
+				resolver->requests.insert(resolver->requests.end(), pending.begin(), pending.end());
+			}
+			pending.clear();
+			resolver->cv.notify_one();
+		#endif
+		}
+
+		//* Reparse /etc/passwd if it has changed, checked at most once every 10 seconds
+		void refresh() {
+			if (Shared::passwd_path.empty() or (last_check > 0 and time_ms() - last_check < 10'000)) return;
+			last_check = time_ms();
+			std::error_code ec;
+			const auto mtime = fs::last_write_time(Shared::passwd_path, ec);
+			if (ec or mtime == passwd_time) return;
+			passwd_time = mtime;
+
+			auto passwd = Shared::proc_dir.read(Shared::passwd_path.c_str());
+			if (passwd.empty()) {
+				Shared::passwd_path.clear();
+				return;
+			}
+			names.clear();
+			//? Lines are "name:password:uid:...", the first entry for a uid is used
+			while (not passwd.empty()) {
+				const auto line_end = passwd.find('\n');
+				const auto line = passwd.substr(0, line_end);
+				passwd.remove_prefix(line_end == std::string_view::npos ? passwd.size() : line_end + 1);
+				const auto name_end = line.find(':');
+				const auto uid_start = line.find(':', name_end == std::string_view::npos ? line.size() : name_end + 1);
+				if (name_end == 0 or uid_start == std::string_view::npos) continue;
+				const auto uid = line.substr(uid_start + 1);
+				if (uid.empty() or not isdigit(static_cast<unsigned char>(uid.front()))) continue;
+				names.try_emplace(sv_to<uint32_t>(uid), line.substr(0, name_end));
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
 		}
-	}
+
+		//* Returns user name for <uid>, or <uid> as a number while the name is resolved in the background after flush()
+		const pooled_string& get(uint32_t uid) {
+			auto [name, inserted] = names.try_emplace(uid);
+			if (inserted) {
+				name->second = to_string(uid);
+				pending.push_back(uid);
+			}
+			return name->second;
+		}
+
+		//* Store names resolved since last call and replace the uid shown for affected processes in <procs>
+		void apply(vector<proc_info>& procs) {
+			if (resolver == nullptr) return;
+			static vector<std::pair<uint32_t, string>> results;
+			{
+				std::lock_guard lck(resolver->mtx);
+				if (resolver->results.empty()) return;
+				results.swap(resolver->results);
+			}
+			for (auto& [uid, name] : results) {
+				if (name.empty()) continue;
+				const pooled_string number{to_string(uid)};
+				auto& cached = names[uid];
+				cached = name;
+				for (auto& p : procs) {
+					if (p.user == number) p.user = cached;
+				}
+			}
+			results.clear();
+		}
+	};
+
+	UidCache uid_cache;
+
+	//? Milliseconds between full listings of /proc when using proc connector events
+	constexpr uint64_t full_scan_interval = 10'000;
 
 	//* Collects and sorts process information from /proc
 	auto collect(bool no_update) -> vector<proc_info>& {
@@ -1694,19 +3805,17 @@ namespace Proc {
 		auto tree = Config::getB("proc_tree");
 		auto show_detailed = Config::getB("show_detailed");
 		const size_t detailed_pid = Config::getI("detailed_pid");
+		static filter_matcher filter_match;
 		bool should_filter = current_filter != filter;
-		if (should_filter) current_filter = filter;
+		if (should_filter) {
+			current_filter = filter;
+			filter_match = filter_matcher{filter};
+		}
 		bool sorted_change = (sorting != current_sort or reverse != current_rev or should_filter);
 		if (sorted_change) {
 			current_sort = sorting;
 			current_rev = reverse;
 		}
-		ifstream pread;
-		string long_string;
-		string short_str;
-
-		static vector<size_t> found;
-
 		const double uptime = system_uptime();
 
 		const int cmult = (per_core) ? Shared::coreCount : 1;
@@ -1721,7 +3830,7 @@ namespace Proc {
 		//* ---------------------------------------------Collection start----------------------------------------------
 		else {
 			should_filter = true;
-			found.clear();
+			generation++;
 
 			//? First make sure kernel proc cache is cleared.
 			if (should_filter_kernel and ++proc_clear_count >= 256) {
@@ -1735,206 +3844,208 @@ namespace Proc {
 			auto totalMem = Mem::get_totalMem();
 			int totalMem_len = to_string(totalMem >> 10).size();
 
-			//? Update uid_user map if /etc/passwd changed since last run
-			if (not Shared::passwd_path.empty() and fs::last_write_time(Shared::passwd_path) != passwd_time) {
-				string r_uid, r_user;
-				passwd_time = fs::last_write_time(Shared::passwd_path);
-				uid_user.clear();
-				pread.open(Shared::passwd_path);
-				if (pread.good()) {
-					while (pread.good()) {
-						getline(pread, r_user, ':');
-						pread.ignore(SSmax, ':');
-						getline(pread, r_uid, ':');
-						if (uid_user.contains(r_uid)) break;
-						uid_user[r_uid] = r_user;
-						pread.ignore(SSmax, '\n');
-					}
-				}
-				else {
-					Shared::passwd_path.clear();
+			uid_cache.refresh();
+			uid_cache.apply(current_procs);
+
+			//? Network rates per process are collected by the tcp helper at its own interval and only copied here
+			if (Config::getB("proc_net")) {
+				Net::tcp_monitor.start(Net::TcpMonitor::user::processes, Config::getI("proc_net_ms"));
+				Net::tcp_monitor.apply(current_procs);
+			}
+			else Net::tcp_monitor.stop(Net::TcpMonitor::user::processes);
+
+			//? Get cpu total times from the shared /proc/stat snapshot, already read this update by Cpu::collect if the cpu box is shown
+			if (not Shared::proc_stat.get(Shared::ProcStat::proc)) throw std::runtime_error("Failure to read /proc/stat");
+			cputimes = Shared::proc_stat.total.sum();
+
+			//? Find or create entries in current_procs for all pids in /proc
+			static vector<proc_read> scan;
+			size_t scan_count = 0;
+			const size_t old_size = current_procs.size();
+
+			//? Remove entries added this update if collection was interrupted, to not leave unread processes in the cache
+			auto interrupted = [&]() -> auto& {
+				for (size_t i = old_size; i < current_procs.size(); i++)
+					pid_index.erase(current_procs[i].pid);
+				current_procs.resize(old_size);
+				proc_events.invalidate();
+				return current_procs;
+			};
+
+			//? Idle processes are read once every idle_ticks updates, spread out by pid
+			const uint64_t idle_ticks = max(1, Config::getI("proc_idle_refresh"));
+
+			//? Check if pid already exists in current_procs, create it if not and mark it as seen in this generation
+			auto add_scan = [&](const size_t pid, bool no_cache) {
+				auto slot = pid_index.find(pid);
+				if (slot == pid_index.end()) {
+					current_procs.push_back({pid});
+					slot = pid_index.emplace(pid, pid_slot{current_procs.size() - 1}).first;
+					no_cache = true;
 				}
-				pread.close();
+				slot->second.seen = generation;
+
+				if (not no_cache and not slot->second.summed and slot->second.hot < generation and pid % idle_ticks != generation % idle_ticks) return;
+
+				if (scan_count == scan.size()) scan.emplace_back();
+				auto& entry = scan[scan_count++];
+				entry.index = slot->second.index;
+				entry.no_cache = no_cache;
+				entry.read_cmd = slot->second.cmd_stale and time_ms() >= slot->second.stale_until;
+				entry.got_uid = false;
+				entry.uid = 0;
+			};
+
+			//? Subscribe to or stop proc connector events if option changed, failure to subscribe is retried only when toggled
+			static bool events_denied{}; // defaults to false
+			static uint64_t last_full_scan{}; // defaults to 0
+			static bool last_filter_kernel{}; // defaults to false
+			if (not Config::getB("proc_events")) {
+				proc_events.stop();
+				events_denied = false;
+			}
+			else if (not proc_events.active() and not events_denied and not proc_events.start()) {
+				events_denied = true;
+				Logger::debug("Proc connector events not available or not permitted, listing /proc every update.");
 			}
 
-			//? Get cpu total times from /proc/stat
-			cputimes = 0;
-			pread.open(Shared::procPath / "stat");
-			if (pread.good()) {
-				pread.ignore(SSmax, ' ');
-				for (uint64_t times; pread >> times; cputimes += times);
+			//? List all of /proc if not using events, periodically and if events were lost
+			bool full_scan = true;
+			if (proc_events.active()) {
+				full_scan = (not proc_events.drain() or time_ms() - last_full_scan >= full_scan_interval
+							or should_filter_kernel != last_filter_kernel);
 			}
-			else throw std::runtime_error("Failure to read /proc/stat");
-			pread.close();
+			last_filter_kernel = should_filter_kernel;
 
-			//? Iterate over all pids in /proc
-			for (const auto& d: fs::directory_iterator(Shared::procPath)) {
-				if (Runner::stopping)
-					return current_procs;
+			if (full_scan) {
+				last_full_scan = time_ms();
+				proc_events.changes.clear();
 
-				if (pread.is_open()) pread.close();
+				for (const auto& d: fs::directory_iterator(Shared::procPath)) {
+					if (Runner::stopping)
+						return interrupted();
 
-				const string pid_str = d.path().filename();
-				if (not isdigit(pid_str[0])) continue;
+					const string pid_str = d.path().filename();
+					if (not isdigit(pid_str[0])) continue;
 
-				const size_t pid = stoul(pid_str);
+					const size_t pid = stoul(pid_str);
 
-				if (should_filter_kernel and kernels_procs.contains(pid)) {
-					continue;
-				}
-
-				found.push_back(pid);
+					if (should_filter_kernel and kernels_procs.contains(pid)) {
+						continue;
+					}
 
-				//? Check if pid already exists in current_procs
-				auto find_old = rng::find(current_procs, pid, &proc_info::pid);
-				bool no_cache{}; // defaults to false
-				if (find_old == current_procs.end()) {
-					current_procs.push_back({pid});
-					find_old = current_procs.end() - 1;
-					no_cache = true;
+					add_scan(pid, false);
 				}
-
-				auto& new_proc = *find_old;
-
-				//? Get program name, command and username
-				if (no_cache) {
-					pread.open(d.path() / "comm");
-					if (not pread.good()) continue;
-					getline(pread, new_proc.name);
-					pread.close();
-					//? Check for whitespace characters in name and set offset to get correct fields from stat file
-					new_proc.name_offset = rng::count(new_proc.name, ' ');
-
-					pread.open(d.path() / "cmdline");
-					if (not pread.good()) continue;
-					long_string.clear();
-					while(getline(pread, long_string, '\0')) {
-						new_proc.cmd += long_string + ' ';
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							break;
-						}
-					}
-					pread.close();
-					if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
-
-					pread.open(d.path() / "status");
-					if (not pread.good()) continue;
-					string uid;
-					string line;
-					while (pread.good()) {
-						getline(pread, line, ':');
-						if (line == "Uid") {
-							pread.ignore();
-							getline(pread, uid, '\t');
-							break;
-						} else {
-							pread.ignore(SSmax, '\n');
-						}
-					}
-					pread.close();
-					if (uid_user.contains(uid)) {
-						new_proc.user = uid_user.at(uid);
-					}
-					else {
-					#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
-						try {
-							struct passwd* udet;
-							udet = getpwuid(stoi(uid));
-							if (udet != nullptr and udet->pw_name != nullptr) {
-								new_proc.user = string(udet->pw_name);
-							}
-							else {
-								new_proc.user = uid;
-							}
+			}
+			else {
+				auto& changes = proc_events.changes;
+
+				//? Keep known processes, reused pids and processes that called exec or exited are read as new
+				for (size_t i = 0; i < old_size; i++) {
+					auto& proc = current_procs[i];
+					bool no_cache{}; // defaults to false
+					if (auto change = changes.find(proc.pid); change != changes.end()) {
+						if (change->second == ProcEvents::Fork) {
+							proc = proc_info{proc.pid};
+
+							//? Refresh state and cpu baseline belong to the old process, only position and tree link are kept
+							auto& slot = pid_index.at(proc.pid);
+							pid_slot fresh{slot.index};
+							fresh.seen = slot.seen;
+							fresh.tree_parent = slot.tree_parent;
+							fresh.in_tree = slot.in_tree;
+							slot = fresh;
 						}
-						catch (...) { new_proc.user = uid; }
-					#else
-						new_proc.user = uid;
-					#endif
+						else proc.short_cmd.clear();
+						no_cache = true;
 					}
+					add_scan(proc.pid, no_cache);
 				}
 
-				//? Parse /proc/[pid]/stat
-				pread.open(d.path() / "stat");
-				if (not pread.good()) continue;
+				//? Add started processes not already known
+				for (const auto& [pid, change] : changes) {
+					if (pid_index.contains(pid) or (should_filter_kernel and kernels_procs.contains(pid))) continue;
+					add_scan(pid, true);
+				}
+				changes.clear();
+			}
 
-				const auto& offset = new_proc.name_offset;
-				short_str.clear();
-				int x = 0, next_x = 3;
-				uint64_t cpu_t = 0;
-				try {
-					for (;;) {
-						while (pread.good() and ++x < next_x + offset) pread.ignore(SSmax, ' ');
-						if (not pread.good()) break;
-						else getline(pread, short_str, ' ');
-
-						switch (x-offset) {
-							case 3: //? Process state
-								new_proc.state = short_str.at(0);
-								if (new_proc.ppid != 0) next_x = 14;
-								continue;
-							case 4: //? Parent pid
-								new_proc.ppid = stoull(short_str);
-								next_x = 14;
-								continue;
-							case 14: //? Process utime
-								cpu_t = stoull(short_str);
-								continue;
-							case 15: //? Process stime
-								cpu_t += stoull(short_str);
-								next_x = 19;
-								continue;
-							case 19: //? Nice value
-								new_proc.p_nice = stoll(short_str);
-								continue;
-							case 20: //? Number of threads
-								new_proc.threads = stoull(short_str);
-								if (new_proc.cpu_s == 0) {
-									next_x = 22;
-									new_proc.cpu_t = cpu_t;
-								}
-								else
-									next_x = 24;
-								continue;
-							case 22: //? Get cpu seconds if missing
-								new_proc.cpu_s = stoull(short_str);
-								next_x = 24;
-								continue;
-							case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
-								if (cmp_greater(short_str.size(), totalMem_len))
-									new_proc.mem = totalMem;
-								else
-									new_proc.mem = stoull(short_str) * Shared::pageSize;
-						}
-						break;
-					}
+			pids_read = scan_count;
+
+			//? Read /proc/[pid] files, split in shards over the worker pool if enabled
+			const size_t proc_threads = max(0, Config::getI("proc_threads"));
+			scan_pool.resize(proc_threads);
+			atomic<bool> read_errors{}; // defaults to false
+			auto read_entry = [&](size_t i) {
+				if (Runner::stopping) return;
+				auto& entry = scan[i];
 
+				//? A process that failed to read is dropped from current_procs and read again as new on the next full scan
+				try {
+					_read_proc(current_procs[entry.index], entry, totalMem, totalMem_len);
+				}
+				catch (const std::exception& e) {
+					entry.status = proc_read::Failed;
+					read_errors = true;
+					Logger::debug("Proc::collect() : reading pid " + to_string(current_procs[entry.index].pid) + " failed: " + string{e.what()});
 				}
-				catch (const std::invalid_argument&) { continue; }
-				catch (const std::out_of_range&) { continue; }
+			};
+			if (scan_pool.size() > 0 and scan_count > 64)
+				scan_pool.run(scan_count, 32, read_entry);
+			else {
+				for (size_t i = 0; i < scan_count; i++) read_entry(i);
+			}
+
+			if (Runner::stopping)
+				return interrupted();
+
+			//? Make the next update list all of /proc so processes dropped after a read error are found again
+			if (read_errors) proc_events.invalidate();
+
+			//? Apply read values in /proc order to keep results identical regardless of how they were read
+			for (size_t i = 0; i < scan_count; i++) {
+				auto& entry = scan[i];
+				auto& new_proc = current_procs[entry.index];
 
-				pread.close();
+				//? Get username from uid
+				if (entry.no_cache and entry.got_uid) new_proc.user = uid_cache.get(entry.uid);
+
+				//? Drop processes that exited before they could be read
+				if (entry.status == proc_read::Failed) {
+					pid_index.at(new_proc.pid).seen = 0;
+					continue;
+				}
 
 				if (should_filter_kernel and new_proc.ppid == KTHREADD) {
 					kernels_procs.emplace(new_proc.pid);
-					found.pop_back();
+					pid_index.at(new_proc.pid).seen = 0;
 				}
 
-				if (x-offset < 24) continue;
+				if (entry.status != proc_read::Done) continue;
 
-				//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
-				if (new_proc.mem >= totalMem) {
-					pread.open(d.path() / "statm");
-					if (not pread.good()) continue;
-					pread.ignore(SSmax, ' ');
-					pread >> new_proc.mem;
-					new_proc.mem *= Shared::pageSize;
-					pread.close();
+				const uint64_t cpu_t = entry.cpu_t;
+				auto& slot = pid_index.at(new_proc.pid);
+
+				//? Mark process stale if reading cmdline timed out and back off before retrying
+				if (entry.no_cache or entry.read_cmd) {
+					using enum DeadlineReader::result;
+					slot.cmd_stale = (entry.cmd_status == TimedOut or entry.cmd_status == Busy);
+					if (entry.cmd_status == TimedOut) {
+						slot.stale_until = time_ms() + stale_delay(slot.backoff++);
+						Logger::debug("Reading cmdline for pid " + to_string(new_proc.pid) + " timed out, retrying in " + to_string(stale_delay(slot.backoff - 1)) + "ms.");
+					}
+					else if (entry.cmd_status == Busy)
+						slot.stale_until = time_ms() + stale_delay(0);
+					else
+						slot.backoff = 0;
 				}
 
-				//? Process cpu usage since last update
-				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+				//? Process cpu usage since it was last read
+				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - slot.cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+				slot.cputimes = cputimes;
+
+				//? Keep recently active processes refreshed every update
+				if (new_proc.cpu_p > 0.0) slot.hot = generation + idle_ticks;
 
 				//? Process cumulative cpu usage since process start
 				new_proc.cpu_c = (double)cpu_t / max(1.0, (uptime * Shared::clkTck) - new_proc.cpu_s);
@@ -1947,9 +4058,22 @@ namespace Proc {
 				}
 			}
 
+			//? Users not known from /etc/passwd found this update are resolved together
+			uid_cache.flush();
+
 			//? Clear dead processes from current_procs and remove kernel processes if enabled
-			auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return not v_contains(found, element.pid); });
-			current_procs.erase(eraser.begin(), eraser.end());
+			size_t alive = 0;
+			for (size_t i = 0; i < current_procs.size(); i++) {
+				auto slot = pid_index.find(current_procs[i].pid);
+				if (slot->second.seen != generation) {
+					_tree_unlink(slot->first, slot->second);
+					pid_index.erase(slot);
+					continue;
+				}
+				if (i != alive) current_procs[alive] = std::move(current_procs[i]);
+				slot->second.index = alive++;
+			}
+			current_procs.resize(alive);
 
 			//? Update the details info box for process if active
 			if (show_detailed and got_detailed) {
@@ -1968,11 +4092,8 @@ namespace Proc {
 		if (should_filter) {
 			filter_found = 0;
 			for (auto& p : current_procs) {
-				if (not tree and not filter.empty()) {
-						if (not s_contains_ic(to_string(p.pid), filter)
-						and not s_contains_ic(p.name, filter)
-						and not s_contains_ic(p.cmd, filter)
-						and not s_contains_ic(p.user, filter)) {
+				if (not tree and not filter_match.empty()) {
+						if (not filter_match(p)) {
 							p.filtered = true;
 							filter_found++;
 							}
@@ -1986,68 +4107,90 @@ namespace Proc {
 			}
 		}
 
-		//* Sort processes
-		if (sorted_change or not no_update) {
-			proc_sorter(current_procs, sorting, reverse, tree);
+		//* Sort processes, only the rows up to one page below the current view are sorted if not in tree mode
+		//? The tree sorts all rows, and sorting again without generating the tree would lose the tree order
+		static size_t sorted_rows{}; // defaults to 0
+		static bool tree_layout{};   // current_procs is ordered as generated by the last tree generation, defaults to false
+		bool reordered = false;
+		const size_t needed_rows = max(0, Config::getI("proc_start")) + select_max;
+		if (sorted_change or not no_update or (not tree and needed_rows > sorted_rows)) {
+			sorted_rows = proc_sorter(current_procs, sorting, reverse, tree, (tree ? 0 : needed_rows + select_max));
+			reordered = true;
+			tree_layout = false;
 		}
 
-		//* Generate tree view if enabled
-		if (tree and (not no_update or should_filter or sorted_change)) {
+		//* Generate tree view if enabled, collapsing or expanding a shown process only moves its subtree if nothing else changed
+		if (tree and (not no_update or should_filter or sorted_change or collapse != -1 or expand != -1)) {
 			bool locate_selection = false;
+			bool generate = not tree_layout;
+			tree_gen_opts opts{filter_match, sorting, reverse, no_update};
+			if (reordered) _update_index();
 			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
-				auto collapser = rng::find(current_procs, find_pid, &proc_info::pid);
-				if (collapser != current_procs.end()) {
-					if (collapse == expand) {
-						collapser->collapsed = not collapser->collapsed;
-					}
-					else if (collapse > -1) {
-						collapser->collapsed = true;
-					}
-					else if (expand > -1) {
-						collapser->collapsed = false;
+				if (auto slot = pid_index.find(find_pid); slot != pid_index.end()) {
+					auto& collapser = current_procs[slot->second.index];
+					const bool collapsed = (collapse == expand ? not collapser.collapsed : collapse > -1);
+					if (generate or not _tree_toggle(collapser, collapsed, opts)) {
+						collapser.collapsed = collapsed;
+						generate = true;
 					}
 					if (Config::ints.at("proc_selected") > 0) locate_selection = true;
 				}
 				collapse = expand = -1;
 			}
-			if (should_filter or not filter.empty()) filter_found = 0;
-
-			vector<tree_proc> tree_procs;
-			tree_procs.reserve(current_procs.size());
+			else generate = true;
+
+			if (generate) {
+				//? Update parent links for new and reparented processes, processes with a missing parent are shown as roots
+				for (auto& p : current_procs) {
+					const size_t parent = (p.ppid != p.pid and pid_index.contains(p.ppid) ? p.ppid : 0);
+					_tree_link(p.pid, pid_index.at(p.pid), parent);
+					p.tree_index = current_procs.size();
+				}
 
-			for (auto& p : current_procs) {
-				if (not v_contains(found, p.ppid)) p.ppid = 0;
+				//? Set filtered state and collapsed values starting from the root processes, then order and index shown processes
+				if (auto roots = tree_children.find(0); roots != tree_children.end()) {
+					for (const auto pid : roots->second) _tree_filter(_tree_proc(pid), 0, false, false, opts);
+				}
+				_tree_order(0, opts);
+				filter_found = current_procs.size() - opts.tree_index;
+
+				//? Move shown processes to their tree index and hidden processes after them
+				static vector<proc_info> tree_sorted;
+				tree_sorted.resize(current_procs.size());
+				for (size_t hidden = opts.tree_index; auto& p : current_procs) {
+					const size_t index = (p.tree_index < opts.tree_index ? p.tree_index : hidden++);
+					pid_index.at(p.pid).index = index;
+					tree_sorted[index] = std::move(p);
+				}
+				current_procs.swap(tree_sorted);
+				tree_layout = true;
 			}
+			reordered = false;
 
-			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(current_procs, rng::less{}, & proc_info::ppid);
-
-			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
+			//? Move current selection/view to the selected process when collapsing/expanding in the tree
+			if (locate_selection) {
+				if (const auto* selected = find_proc(Proc::selected_pid); selected != nullptr and not selected->filtered) {
+					const int loc = selected->tree_index;
+					if (Config::ints.at("proc_start") >= loc or Config::ints.at("proc_start") <= loc - Proc::select_max)
+						Config::ints.at("proc_start") = max(0, loc - 1);
+					Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
+				}
 			}
+		}
 
-			//? Recursive sort over tree structure to account for collapsed processes in the tree
-			int index = 0;
-			tree_sort(tree_procs, sorting, reverse, index, current_procs.size());
-
-			//? Add tree begin symbol to first item if childless
-			if (tree_procs.size() > 0 and tree_procs.front().children.empty() and tree_procs.front().entry.get().prefix.size() >= 8)
-				tree_procs.front().entry.get().prefix.replace(tree_procs.front().entry.get().prefix.size() - 8, 8, " ┌─ ");
-
-			//? Add tree terminator symbol to last item if childless
-			if (tree_procs.size() > 0 and tree_procs.back().children.empty() and tree_procs.back().entry.get().prefix.size() >= 8)
-				tree_procs.back().entry.get().prefix.replace(tree_procs.back().entry.get().prefix.size() - 8, 8, " └─ ");
-
-			//? Final sort based on tree index
-			rng::sort(current_procs, rng::less{}, & proc_info::tree_index);
+		//? Keep pid index in sync with the order from proc_sorter() if the tree didn't set it
+		if (reordered) _update_index();
 
-			//? Move current selection/view to the selected process when collapsing/expanding in the tree
-			if (locate_selection) {
-				int loc = rng::find(current_procs, Proc::selected_pid, &proc_info::pid)->tree_index;
-				if (Config::ints.at("proc_start") >= loc or Config::ints.at("proc_start") <= loc - Proc::select_max)
-					Config::ints.at("proc_start") = max(0, loc - 1);
-				Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
+		//? Mark processes currently shown and the one in the detailed box to be refreshed next update
+		if (Config::getI("proc_idle_refresh") > 1) {
+			const int proc_start = Config::getI("proc_start");
+			for (int n = 0; auto& p : current_procs) {
+				if (p.filtered or (tree and p.tree_index == current_procs.size()) or n++ < proc_start) continue;
+				if (n > proc_start + select_max) break;
+				pid_index.at(p.pid).hot = generation + 1;
+			}
+			if (show_detailed) {
+				if (auto slot = pid_index.find(detailed_pid); slot != pid_index.end()) slot->second.hot = generation + 1;
 			}
 		}
 
@@ -2059,16 +4202,12 @@ namespace Proc {
 
 namespace Tools {
 	double system_uptime() {
-		string upstr;
-		ifstream pread(Shared::procPath / "uptime");
-		if (pread.good()) {
-			try {
-				getline(pread, upstr, ' ');
-				pread.close();
-				return stod(upstr);
-			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
+		auto uptime = Shared::proc_dir.read("uptime", 64);
+		if (not uptime.empty()) {
+			//? Buffer is null terminated so strtod stops at the end of the view at most
+			char* end = nullptr;
+			const double seconds = std::strtod(uptime.data(), &end);
+			if (end != uptime.data()) return seconds;
 		}
 		throw std::runtime_error("Failed get uptime from from " + string{Shared::procPath} + "/uptime");
 	}
@@ -170,8 +170,8 @@ namespace Shared {
 		Cpu::core_old_totals.insert(Cpu::core_old_totals.begin(), Shared::coreCount, 0);
 		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
 		Cpu::collect();
-		for (auto &[field, vec] : Cpu::current_cpu.cpu_percent) {
-			if (not vec.empty() and not v_contains(Cpu::available_fields, field)) Cpu::available_fields.push_back(field);
+		for (const auto& name : Cpu::field_names) {
+			if (not Cpu::current_cpu.cpu_percent.at(name).empty() and not v_contains(Cpu::available_fields, name)) Cpu::available_fields.push_back(string(name));
 		}
 		Cpu::cpuName = Cpu::get_cpuName();
 		Cpu::got_sensors = Cpu::get_sensors();
@@ -188,6 +188,7 @@ namespace Cpu {
 	string cpuName;
 	string cpuHz;
 	bool has_battery = true;
+	bool has_core_freq{}; // defaults to false
 	bool macM1 = false;
 	tuple<int, long, string> current_bat;
 
@@ -444,7 +445,7 @@ namespace Cpu {
 	}
 
 	auto collect(bool no_update) -> cpu_info & {
-		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty()))
+		if (Runner::stopping or (no_update and not current_cpu.cpu_percent[field::total].empty()))
 			return current_cpu;
 		auto &cpu = current_cpu;
 
@@ -521,10 +522,10 @@ namespace Cpu {
 		cpu_old.at("idles") = global_idles;
 
 		//? Total usage of cpu
-		cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+		cpu.cpu_percent[field::total].push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
 
 		//? Reduce size if there are more values than needed for graph
-		while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
+		while (cmp_greater(cpu.cpu_percent[field::total].size(), width * 2)) cpu.cpu_percent[field::total].pop_front();
 
 		if (Config::getB("show_cpu_freq")) {
 			auto hz = get_cpuHz();
@@ -665,7 +666,7 @@ namespace Mem {
 	}
 
 	auto collect(bool no_update) -> mem_info & {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty()))
+		if (Runner::stopping or (no_update and not current_mem.percent[field::used].empty()))
 			return current_mem;
 
 		auto show_swap = Config::getB("show_swap");
@@ -677,10 +678,10 @@ namespace Mem {
 		vm_statistics64 p;
 		mach_msg_type_number_t info_size = HOST_VM_INFO64_COUNT;
 		if (host_statistics64(mach_host_self(), HOST_VM_INFO64, (host_info64_t)&p, &info_size) == 0) {
-			mem.stats.at("free") = p.free_count * Shared::pageSize;
-			mem.stats.at("cached") = p.external_page_count * Shared::pageSize;
-			mem.stats.at("used") = (p.active_count + p.inactive_count + p.wire_count) * Shared::pageSize;
-			mem.stats.at("available") = Shared::totalMem - mem.stats.at("used");
+			mem.stats[field::free] = p.free_count * Shared::pageSize;
+			mem.stats[field::cached] = p.external_page_count * Shared::pageSize;
+			mem.stats[field::used] = (p.active_count + p.inactive_count + p.wire_count) * Shared::pageSize;
+			mem.stats[field::available] = Shared::totalMem - mem.stats[field::used];
 		}
 
 		int mib[2] = {CTL_VM, VM_SWAPUSAGE};
@@ -688,14 +689,14 @@ namespace Mem {
 		struct xsw_usage swap;
 		size_t len = sizeof(struct xsw_usage);
 		if (sysctl(mib, 2, &swap, &len, nullptr, 0) == 0) {
-			mem.stats.at("swap_total") = swap.xsu_total;
-			mem.stats.at("swap_free") = swap.xsu_avail;
-			mem.stats.at("swap_used") = swap.xsu_used;
+			mem.stats[field::swap_total] = swap.xsu_total;
+			mem.stats[field::swap_free] = swap.xsu_avail;
+			mem.stats[field::swap_used] = swap.xsu_used;
 		}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
+		if (show_swap and mem.stats[field::swap_total] > 0) {
 			for (const auto &name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
+				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats[field::swap_total]));
 				while (cmp_greater(mem.percent.at(name).size(), width * 2))
 					mem.percent.at(name).pop_front();
 			}
@@ -802,11 +803,11 @@ namespace Mem {
 				mem.disks_order.push_back("swap");
 				if (not disks.contains("swap"))
 					disks["swap"] = {"", "swap"};
-				disks.at("swap").total = mem.stats.at("swap_total");
-				disks.at("swap").used = mem.stats.at("swap_used");
-				disks.at("swap").free = mem.stats.at("swap_free");
-				disks.at("swap").used_percent = mem.percent.at("swap_used").back();
-				disks.at("swap").free_percent = mem.percent.at("swap_free").back();
+				disks.at("swap").total = mem.stats[field::swap_total];
+				disks.at("swap").used = mem.stats[field::swap_used];
+				disks.at("swap").free = mem.stats[field::swap_free];
+				disks.at("swap").used_percent = mem.percent[field::swap_used].back();
+				disks.at("swap").free_percent = mem.percent[field::swap_free].back();
 			}
 			for (const auto &name : last_found)
 				if (not is_in(name, "/", "swap", "/dev"))
@@ -828,7 +829,11 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors = 0;
-	unordered_flat_map<string, uint64_t> graph_max = {{"download", {}}, {"upload", {}}};
+	per_direction<uint64_t> graph_max;
+	per_direction<uint64_t> packet_max;
+	vector<connection_info> connections;
+	size_t connection_count{};  // defaults to 0
+	enum_array<protocol, RingBuffer<long long>, protocol_names> protocols;
 	unordered_flat_map<string, array<int, 2>> max_count = {{"download", {}}, {"upload", {}}};
 	bool rescale = true;
 	uint64_t timestamp = 0;
@@ -1000,8 +1005,8 @@ namespace Net {
 				//? Sort interfaces by total upload + download bytes
 				auto sorted_interfaces = interfaces;
 				rng::sort(sorted_interfaces, [&](const auto &a, const auto &b) {
-					return cmp_greater(net.at(a).stat["download"].total + net.at(a).stat["upload"].total,
-									   net.at(b).stat["download"].total + net.at(b).stat["upload"].total);
+					return cmp_greater(net.at(a).stat[direction::download].total + net.at(a).stat[direction::upload].total,
+									   net.at(b).stat[direction::download].total + net.at(b).stat[direction::upload].total);
 				});
 				selected_iface.clear();
 				//? Try to set to a connected interface
@@ -1062,6 +1067,7 @@ namespace Proc {
 	int collapse = -1, expand = -1;
 	uint64_t old_cputimes = 0;
 	atomic<int> numpids = 0;
+	atomic<int> pids_read = 0;
 	int filter_found = 0;
 
 	detail_container detailed;
@@ -1127,6 +1133,8 @@ namespace Proc {
 
 	//* Collects and sorts process information from /proc
 	auto collect(bool no_update) -> vector<proc_info> & {
+		//? Collapsing or expanding in the tree reads new values, since sums of collapsed children are only added on new data
+		if (collapse != -1 or expand != -1) no_update = false;
 		const auto &sorting = Config::getS("proc_sorting");
 		auto reverse = Config::getB("proc_reversed");
 		const auto &filter = Config::getS("proc_filter");
@@ -1134,8 +1142,12 @@ namespace Proc {
 		auto tree = Config::getB("proc_tree");
 		auto show_detailed = Config::getB("show_detailed");
 		const size_t detailed_pid = Config::getI("detailed_pid");
+		static filter_matcher filter_match;
 		bool should_filter = current_filter != filter;
-		if (should_filter) current_filter = filter;
+		if (should_filter) {
+			current_filter = filter;
+			filter_match = filter_matcher{filter};
+		}
 		bool sorted_change = (sorting != current_sort or reverse != current_rev or should_filter);
 		if (sorted_change) {
 			current_sort = sorting;
@@ -1211,6 +1223,7 @@ namespace Proc {
 						size_t lastSlash = f_name.find_last_of('/');
 						new_proc.name = f_name.substr(lastSlash + 1);
 						//? Get process arguments if possible, fallback to process path in case of failure
+						string cmd;
 						if (Shared::arg_max > 0) {
 							std::unique_ptr<char[]> proc_chars(new char[Shared::arg_max]);
 							int mib[] = {CTL_KERN, KERN_PROCARGS2, (int)pid};
@@ -1221,21 +1234,19 @@ namespace Proc {
 								std::string_view proc_args(proc_chars.get(), argmax);
 								if (size_t null_pos = proc_args.find('\0', sizeof(argc)); null_pos != string::npos) {
 									if (size_t start_pos = proc_args.find_first_not_of('\0', null_pos); start_pos != string::npos) {
-										while (argc-- > 0 and null_pos != string::npos and cmp_less(new_proc.cmd.size(), 1000)) {
+										while (argc-- > 0 and null_pos != string::npos and cmp_less(cmd.size(), 1000)) {
 											null_pos = proc_args.find('\0', start_pos);
-											new_proc.cmd += (string)proc_args.substr(start_pos, null_pos - start_pos) + ' ';
+											cmd += (string)proc_args.substr(start_pos, null_pos - start_pos) + ' ';
 											start_pos = null_pos + 1;
 										}
 									}
 								}
-								if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
+								if (not cmd.empty()) cmd.pop_back();
 							}
 						}
-						if (new_proc.cmd.empty()) new_proc.cmd = f_name;
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							new_proc.cmd.shrink_to_fit();
-						}
+						if (cmd.empty()) cmd = f_name;
+						if (cmd.size() > 1000) cmd.resize(1000);
+						new_proc.cmd = cmd;
 						new_proc.ppid = kproc.kp_eproc.e_ppid;
 						new_proc.cpu_s = kproc.kp_proc.p_starttime.tv_sec * 1'000'000 + kproc.kp_proc.p_starttime.tv_usec;
 						struct passwd *pwd = getpwuid(kproc.kp_eproc.e_ucred.cr_uid);
@@ -1290,8 +1301,8 @@ namespace Proc {
 		if (should_filter) {
 			filter_found = 0;
 			for (auto &p : current_procs) {
-				if (not tree and not filter.empty()) {
-					if (not s_contains_ic(to_string(p.pid), filter) and not s_contains_ic(p.name, filter) and not s_contains_ic(p.cmd, filter) and not s_contains_ic(p.user, filter)) {
+				if (not tree and not filter_match.empty()) {
+					if (not filter_match(p)) {
 						p.filtered = true;
 						filter_found++;
 					} else {
@@ -1341,7 +1352,7 @@ namespace Proc {
 
 			//? Start recursive iteration over processes with the lowest shared parent pids
 			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
+				_tree_gen(p, current_procs, tree_procs, 0, false, filter_match, false, no_update, should_filter);
 			}
 
 			//? Recursive sort over tree structure to account for collapsed processes in the tree
@@ -1369,6 +1380,7 @@ namespace Proc {
 		}
 
 		numpids = (int)current_procs.size() - filter_found;
+		pids_read = (int)current_procs.size();
 		return current_procs;
 	}
 }  // namespace Proc